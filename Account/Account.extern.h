@@ -26,5 +26,7 @@
 
 // Define external global functions.
 #ifndef __MQL__
+extern double AccountInfoDouble(ENUM_ACCOUNT_INFO_DOUBLE property_id);
+extern long AccountInfoInteger(ENUM_ACCOUNT_INFO_INTEGER property_id);
 extern string AccountInfoString(ENUM_ACCOUNT_INFO_STRING property_id);
 #endif
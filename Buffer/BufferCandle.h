@@ -25,54 +25,64 @@
 #define BUFFER_CANDLE_H
 
 // Includes.
-#include "../BufferStruct.mqh"
 #include "../Candle.struct.h"
+#include "BufferSeries.h"
 
 /**
- * Class to store struct data.
+ * Class to store candles ordered by their timestamps.
  */
 template <typename TV>
-class BufferCandle : public BufferStruct<CandleOCTOHLC<TV>> {
- protected:
- protected:
-  /* Protected methods */
+class BufferCandle : public BufferSeries<CandleOCTOHLC<TV>> {
+ public:
+  /* Constructors */
 
   /**
-   * Initialize class.
-   *
-   * Called on constructor.
+   * Constructor.
    */
-  void Init() { SetOverflowListener(BufferCandleOverflowListener, 10); }
+  BufferCandle(int _capacity = 86400) : BufferSeries<CandleOCTOHLC<TV>>(_capacity) {}
+  BufferCandle(BufferCandle& _right) { THIS_REF = _right; }
 
- public:
-  /* Constructors */
+  /* Modifiers */
 
   /**
-   * Constructor.
+   * Updates candle of the given timestamp by tick's price or adds a new candle when there is none.
+   *
+   * Existing candle is updated in place and the newest (still forming) one is found in O(1), so there is a single
+   * lookup per tick.
    */
-  BufferCandle() { Init(); }
-  BufferCandle(BufferCandle& _right) {
-    THIS_REF = _right;
-    Init();
+  bool Update(long _candle_timestamp, long _tick_timestamp, TV _price) {
+    int _index = THIS_ATTR IndexOf(_candle_timestamp);
+    if (_index != -1) {
+      THIS_ATTR items[THIS_ATTR Pos(_index)].Update(_tick_timestamp, _price);
+      return true;
+    }
+    CandleOCTOHLC<TV> _candle(_price, _price, _price, _price, _tick_timestamp, _tick_timestamp);
+    return THIS_ATTR Add(_candle, _candle_timestamp);
   }
 
-  /* Callback methods */
-
   /**
-   * Function should return true if resize can be made, or false to overwrite current slot.
+   * Updates candle of the given timestamp by candle of a shorter timeframe or adds a new candle when there is none.
    */
-  static bool BufferCandleOverflowListener(ENUM_DICT_OVERFLOW_REASON _reason, int _size, int _num_conflicts) {
-    static int cache_limit = 86400;
-    switch (_reason) {
-      case DICT_OVERFLOW_REASON_FULL:
-        // We allow resize if dictionary size is less than 86400 slots.
-        return _size < cache_limit;
-      case DICT_OVERFLOW_REASON_TOO_MANY_CONFLICTS:
-      default:
-        // When there is too many conflicts, we just reject doing resize, so first conflicting slot will be reused.
-        break;
+  bool Update(long _candle_timestamp, CandleOCTOHLC<TV>& _candle) {
+    int _index = THIS_ATTR IndexOf(_candle_timestamp);
+    if (_index != -1) {
+      THIS_ATTR items[THIS_ATTR Pos(_index)].Update(_candle);
+      return true;
     }
-    return false;
+    return THIS_ATTR Add(_candle, _candle_timestamp);
+  }
+
+  /* Getters */
+
+  /**
+   * Returns logical index (0 is the oldest) of the candle at the given timestamp or of the nearest older one, or -1
+   * if there is none.
+   *
+   * Shift (0 is the newest) is used as a hint, so lookups are O(1) when there are no gaps between candles and
+   * O(log n) for sparse history.
+   */
+  int GetIndexByShift(int _shift, long _candle_timestamp) {
+    return THIS_ATTR IndexOfNearest(_candle_timestamp, THIS_ATTR Size() - 1 - _shift);
   }
 };
 
@@ -0,0 +1,270 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef BUFFER_CANDLE_CASCADE_H
+#define BUFFER_CANDLE_CASCADE_H
+
+// Includes.
+#include "../Refs.mqh"
+#include "BufferCandle.h"
+
+/**
+ * Candles of multiple timeframes built from a single stream of ticks.
+ *
+ * Ticks only update candles of the finest timeframe. Each coarser timeframe is rolled up from closed candles of the
+ * longest finer timeframe it's divisible by (e.g., M15 from M5, H1 from M15), which happens once per closed candle.
+ * Candle which is still forming is merged on read from the forming candles of the finer timeframes. This way each
+ * tick costs a single candle update no matter how many timeframes are kept.
+ */
+template <typename TV>
+class BufferCandleCascade : public Dynamic {
+ protected:
+  // Candles of each timeframe (level), in order of addition. Forming candles of coarser levels aren't complete.
+  ARRAY(BufferCandle<TV>*, candles);
+  // Seconds per candle of each level.
+  ARRAY(int, spcs);
+  // Finer level each level is rolled up from or -1 when built from ticks.
+  ARRAY(int, sources);
+  // Last processed tick.
+  long last_tick_time;
+  TV last_tick_price;
+
+  /* Protected methods */
+
+  /**
+   * Calculates candle's timestamp of the given level.
+   */
+  long CalcCandleTimestamp(int _level, long _timestamp) { return _timestamp - _timestamp % spcs[_level]; }
+
+  /**
+   * Links levels to the finer levels they're rolled up from.
+   */
+  void LinkLevels() {
+    for (int i = 0; i < ArraySize(spcs); ++i) {
+      sources[i] = -1;
+      for (int j = 0; j < ArraySize(spcs); ++j) {
+        if (spcs[j] < spcs[i] && spcs[i] % spcs[j] == 0 && (sources[i] == -1 || spcs[j] > spcs[sources[i]])) {
+          sources[i] = j;
+        }
+      }
+    }
+  }
+
+  /**
+   * Rolls up closed candle of the given level into all the levels built from it.
+   *
+   * @param _timestamp
+   *   Timestamp of the tick which closed the candle.
+   */
+  void RollUp(int _level, long _candle_timestamp, CandleOCTOHLC<TV>& _candle, long _timestamp) {
+    for (int i = 0; i < ArraySize(sources); ++i) {
+      if (sources[i] == _level) {
+        candles[i] PTR_DEREF Update(CalcCandleTimestamp(i, _candle_timestamp), _candle);
+        Close(i, _timestamp);
+      }
+    }
+  }
+
+  /**
+   * Rolls up the newest candle of the given level if tick of the given timestamp belongs to a newer candle.
+   *
+   * Candles of the coarser levels may only close along with the candle of the finer level, so closing propagates up.
+   */
+  void Close(int _level, long _timestamp) {
+    BufferCandle<TV>* _candles = candles[_level];
+    if (_candles PTR_DEREF Size() > 0 && CalcCandleTimestamp(_level, _timestamp) > _candles PTR_DEREF GetMax()) {
+      CandleOCTOHLC<TV> _closed = _candles PTR_DEREF GetByShift(0);
+      RollUp(_level, _candles PTR_DEREF GetMax(), _closed, _timestamp);
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  BufferCandleCascade() : last_tick_time(-1), last_tick_price(0) {}
+
+  /**
+   * Destructor.
+   */
+  ~BufferCandleCascade() {
+    for (int i = 0; i < ArraySize(candles); ++i) {
+      delete candles[i];
+    }
+  }
+
+  /* Modifiers */
+
+  /**
+   * Adds timeframe of the given seconds per candle, if not yet added.
+   *
+   * Levels should be added before ticks are fed. Level added later is filled from the closed candles of the level it
+   * is rolled up from.
+   *
+   * @return
+   *   Returns level's index to be used with other methods.
+   */
+  int AddLevel(int _spc) {
+    int _level = GetLevel(_spc);
+    if (_level != -1) {
+      return _level;
+    }
+    _level = ArraySize(spcs);
+    ArrayResize(candles, _level + 1);
+    ArrayResize(spcs, _level + 1);
+    ArrayResize(sources, _level + 1);
+    candles[_level] = new BufferCandle<TV>();
+    spcs[_level] = _spc;
+    LinkLevels();
+
+    int _source = sources[_level];
+    if (_source != -1) {
+      BufferCandle<TV>* _source_candles = candles[_source];
+      // Candles older than the forming one are closed.
+      long _forming = GetNewestTimestamp(_source);
+      for (int i = 0; i < _source_candles PTR_DEREF Size() && _source_candles PTR_DEREF GetKeyByIndex(i) < _forming;
+           ++i) {
+        CandleOCTOHLC<TV> _candle = _source_candles PTR_DEREF GetByIndex(i);
+        long _timestamp = CalcCandleTimestamp(_level, _source_candles PTR_DEREF GetKeyByIndex(i));
+        candles[_level] PTR_DEREF Update(_timestamp, _candle);
+      }
+    }
+    return _level;
+  }
+
+  /**
+   * Updates candles by tick's price.
+   *
+   * Repeated tick is skipped, so all indicators sharing the cascade may pass the same tick to it. Repeating a tick
+   * doesn't change OHLC values anyway.
+   */
+  void Tick(long _timestamp, TV _price) {
+    if (_timestamp == last_tick_time && _price == last_tick_price) {
+      return;
+    }
+    last_tick_time = _timestamp;
+    last_tick_price = _price;
+    for (int i = 0; i < ArraySize(sources); ++i) {
+      if (sources[i] == -1) {
+        Close(i, _timestamp);
+        candles[i] PTR_DEREF Update(CalcCandleTimestamp(i, _timestamp), _timestamp, _price);
+      }
+    }
+  }
+
+  /* Getters */
+
+  /**
+   * Returns level of the given seconds per candle or -1 if not added.
+   */
+  int GetLevel(int _spc) {
+    for (int i = 0; i < ArraySize(spcs); ++i) {
+      if (spcs[i] == _spc) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * Returns seconds per candle of the given level.
+   */
+  int GetSecsPerCandle(int _level) { return spcs[_level]; }
+
+  /**
+   * Returns candles of the given level. Candle which is still forming may miss the most recent ticks on coarser
+   * levels, use GetCandle() to get it complete.
+   */
+  BufferCandle<TV>* GetCandles(int _level) { return candles[_level]; }
+
+  /**
+   * Returns timestamp of the newest candle of the given level or -1 if there is none.
+   */
+  long GetNewestTimestamp(int _level) {
+    long _newest = candles[_level] PTR_DEREF Size() > 0 ? candles[_level] PTR_DEREF GetMax() : -1;
+    if (sources[_level] != -1) {
+      long _source_newest = GetNewestTimestamp(sources[_level]);
+      if (_source_newest != -1) {
+        _newest = MathMax(_newest, CalcCandleTimestamp(_level, _source_newest));
+      }
+    }
+    return _newest;
+  }
+
+  /**
+   * Returns timestamp of the oldest candle of the given level or -1 if there is none.
+   */
+  long GetOldestTimestamp(int _level) {
+    long _oldest = candles[_level] PTR_DEREF Size() > 0 ? candles[_level] PTR_DEREF GetMin() : -1;
+    if (sources[_level] != -1) {
+      long _source_oldest = GetOldestTimestamp(sources[_level]);
+      if (_source_oldest != -1) {
+        _source_oldest = CalcCandleTimestamp(_level, _source_oldest);
+        _oldest = _oldest == -1 ? _source_oldest : MathMin(_oldest, _source_oldest);
+      }
+    }
+    return _oldest;
+  }
+
+  /**
+   * Returns candle of the given level with the given timestamp or the nearest older one (when there were no ticks
+   * during the candle).
+   *
+   * @param _shift
+   *   Expected shift of the candle (0 is the newest), so lookup is O(1) when there are no gaps between candles.
+   */
+  CandleOCTOHLC<TV> GetCandle(int _level, long _candle_timestamp, int _shift = 0) {
+    CandleOCTOHLC<TV> _candle;
+    BufferCandle<TV>* _candles = candles[_level];
+    long _source_newest = sources[_level] != -1 ? GetNewestTimestamp(sources[_level]) : -1;
+    long _forming_timestamp = _source_newest != -1 ? CalcCandleTimestamp(_level, _source_newest) : -1;
+    if (_forming_timestamp != -1 &&
+        (_candles PTR_DEREF Size() == 0 || _forming_timestamp > _candles PTR_DEREF GetMax())) {
+      // Forming candle has no closed candles of the finer level yet, so it isn't stored.
+      --_shift;
+    }
+    int _index = _candles PTR_DEREF GetIndexByShift(_shift, _candle_timestamp);
+    long _timestamp = -1;
+    if (_index != -1) {
+      _candle = _candles PTR_DEREF GetByIndex(_index);
+      _timestamp = _candles PTR_DEREF GetKeyByIndex(_index);
+    }
+    if (_forming_timestamp != -1 && _forming_timestamp <= _candle_timestamp && _forming_timestamp >= _timestamp) {
+      // Merging forming candle of the finer level, as it isn't rolled up yet.
+      CandleOCTOHLC<TV> _forming = GetCandle(sources[_level], _source_newest);
+      if (_forming_timestamp == _timestamp) {
+        _candle.Update(_forming);
+      } else {
+        _candle = _forming;
+      }
+    }
+    return _candle;
+  }
+};
+
+#endif  // BUFFER_CANDLE_CASCADE_H
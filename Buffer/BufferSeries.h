@@ -0,0 +1,437 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Prevents processing this includes file for the second time.
+#ifndef BUFFER_SERIES_H
+#define BUFFER_SERIES_H
+
+// Includes.
+#include "../Std.h"
+
+// Defines.
+#define BUFFER_SERIES_CAPACITY_DEFAULT 10000
+#define BUFFER_SERIES_MIN_ALLOC 16
+
+// Forward declarations.
+template <typename TStruct>
+class BufferSeries;
+
+/**
+ * Iterates over BufferSeries entries from the oldest to the newest one.
+ */
+template <typename TStruct>
+class BufferSeriesIterator {
+ protected:
+  BufferSeries<TStruct>* series;
+  int index;
+
+ public:
+  /**
+   * Constructor.
+   */
+  BufferSeriesIterator() : series(NULL), index(0) {}
+  BufferSeriesIterator(BufferSeries<TStruct>& _series, int _index) : series(&_series), index(_index) {}
+  BufferSeriesIterator(const BufferSeriesIterator& _right) : series(_right.series), index(_right.index) {}
+
+  /**
+   * Moves iterator to the next (newer) entry.
+   */
+  void operator++(void) { ++index; }
+
+  /**
+   * Checks whether iterator points to an existing entry.
+   */
+  bool IsValid() { return series != NULL && index < series PTR_DEREF Size(); }
+
+  /**
+   * Returns logical index of the current entry (0 is the oldest one).
+   */
+  int Index() { return index; }
+
+  /**
+   * Returns timestamp of the current entry.
+   */
+  long Key() { return series PTR_DEREF GetKeyByIndex(index); }
+
+  /**
+   * Returns current entry.
+   */
+  TStruct Value() { return series PTR_DEREF GetByIndex(index); }
+};
+
+/**
+ * Time-ordered, capacity-bounded ring buffer of structs keyed by timestamp.
+ *
+ * Entries are kept in ascending order of their timestamps in a contiguous ring, so appending the newest entry and
+ * evicting the oldest ones are O(1), while lookups by timestamp are O(log n) binary searches. Once the capacity is
+ * reached, appending evicts the oldest entry, so memory stays flat regardless of how long the series is fed.
+ */
+template <typename TStruct>
+class BufferSeries {
+ protected:
+  ARRAY(TStruct, items);
+  ARRAY(long, times);
+  // Physical position of the oldest entry.
+  int head;
+  // Number of stored entries.
+  int count;
+  // Maximum number of entries kept.
+  int capacity;
+
+  /* Protected methods */
+
+  /**
+   * Converts logical index (0 is the oldest) into the physical position in the ring.
+   */
+  int Pos(int _index) {
+    int _alloc = ArraySize(times);
+    int _pos = head + _index;
+    return _pos >= _alloc ? _pos - _alloc : _pos;
+  }
+
+  /**
+   * Enlarges the ring while keeping the order of entries.
+   *
+   * @param _min_alloc
+   *   Minimum number of entries to allocate room for. Ring is doubled otherwise.
+   */
+  bool Grow(int _min_alloc = 0) {
+    int _alloc = ArraySize(times);
+    if (_alloc >= capacity) {
+      return false;
+    }
+    int _new_alloc = (int)MathMin(MathMax(MathMax(_alloc * 2, BUFFER_SERIES_MIN_ALLOC), _min_alloc), capacity);
+    if (ArrayResize(times, _new_alloc) != _new_alloc || ArrayResize(items, _new_alloc) != _new_alloc) {
+      return false;
+    }
+    if (head > 0 && count > 0) {
+      // Moves wrapped segment [head, _alloc) to the end of the enlarged ring.
+      int _tail = _alloc - head;
+      for (int i = _tail - 1; i >= 0; --i) {
+        times[_new_alloc - _tail + i] = times[head + i];
+        items[_new_alloc - _tail + i] = items[head + i];
+      }
+      head = _new_alloc - _tail;
+    }
+    return true;
+  }
+
+  /**
+   * Drops the oldest entry.
+   */
+  void PopFront() {
+    if (count > 0) {
+      head = Pos(1);
+      --count;
+    }
+  }
+
+ public:
+  /* Constructors */
+
+  /**
+   * Constructor.
+   */
+  BufferSeries(int _capacity = BUFFER_SERIES_CAPACITY_DEFAULT) : head(0), count(0), capacity(_capacity) {}
+  BufferSeries(const BufferSeries& _right) : head(0), count(0), capacity(_right.capacity) { THIS_REF = _right; }
+
+  /**
+   * Copies entries from another buffer.
+   */
+  void operator=(const BufferSeries& _right) {
+    int _size = _right.count;
+    capacity = _right.capacity;
+    head = 0;
+    count = 0;
+    ArrayResize(times, _size);
+    ArrayResize(items, _size);
+    for (int i = 0; i < _size; ++i) {
+      int _pos = _right.head + i;
+      _pos = _pos >= ArraySize(_right.times) ? _pos - ArraySize(_right.times) : _pos;
+      times[i] = _right.times[_pos];
+      items[i] = _right.items[_pos];
+    }
+    count = _size;
+  }
+
+  /* Modifiers */
+
+  /**
+   * Adds new value.
+   *
+   * Newer entries are appended in O(1), existing timestamps are overwritten in place. Older (out-of-order) entries
+   * are inserted at their place, which requires shifting the newer ones.
+   *
+   * @return
+   *   Returns false when entry is older than all the entries of the full buffer, so it couldn't be stored.
+   */
+  bool Add(TStruct& _value, long _dt = 0) {
+    _dt = _dt > 0 ? _dt : (long)TimeCurrent();
+    int _index = count;
+    if (count > 0 && _dt <= times[Pos(count - 1)]) {
+      // Newest entry (e.g., still forming candle) is found in O(1), older ones by binary search.
+      _index = _dt == times[Pos(count - 1)] ? count - 1 : LowerBound(_dt);
+    }
+
+    if (_index < count && times[Pos(_index)] == _dt) {
+      // Updating existing entry.
+      items[Pos(_index)] = _value;
+      return true;
+    }
+
+    if (count == ArraySize(times) && !Grow()) {
+      if (_index == 0) {
+        // Entry is older than everything kept in the full buffer.
+        return false;
+      }
+      PopFront();
+      --_index;
+    }
+
+    // Shifting newer entries to make room for the out-of-order one.
+    for (int i = count; i > _index; --i) {
+      times[Pos(i)] = times[Pos(i - 1)];
+      items[Pos(i)] = items[Pos(i - 1)];
+    }
+
+    times[Pos(_index)] = _dt;
+    items[Pos(_index)] = _value;
+    ++count;
+    return true;
+  }
+
+  /**
+   * Adds values in bulk, e.g., when loading history.
+   *
+   * Values newer than the newest entry are appended straight into the ring, each in O(1) without searching or shifting
+   * the entries, and room for all of them is allocated at once. Values with timestamp of the newest entry overwrite
+   * it. Older values fall back to Add().
+   *
+   * @param _count
+   *   Number of values to add (from the beginning of the arrays) or WHOLE_ARRAY for all.
+   *
+   * @return
+   *   Returns number of stored values.
+   */
+  int AddRange(ARRAY_REF(TStruct, _values), ARRAY_REF(long, _dts), int _count = WHOLE_ARRAY) {
+    _count = _count < 0 ? ArraySize(_values) : MathMin(_count, ArraySize(_values));
+    int _result = 0;
+    if (!Reserve(count + _count) && ArraySize(times) == 0) {
+      return 0;
+    }
+    for (int i = 0; i < _count; ++i) {
+      long _dt = _dts[i];
+      long _max = count > 0 ? times[Pos(count - 1)] : 0;
+      if (count == 0 || _dt > _max) {
+        if (count == ArraySize(times)) {
+          PopFront();
+        }
+        int _pos = Pos(count);
+        times[_pos] = _dt;
+        items[_pos] = _values[i];
+        ++count;
+        ++_result;
+      } else if (_dt == _max) {
+        items[Pos(count - 1)] = _values[i];
+        ++_result;
+      } else {
+        _result += Add(_values[i], _dt) ? 1 : 0;
+      }
+    }
+    return _result;
+  }
+
+  /**
+   * Allocates room for the given number of entries (up to the capacity) at once, e.g., before adding many entries.
+   */
+  bool Reserve(int _size) { return ArraySize(times) >= MathMin(_size, capacity) || Grow(_size); }
+
+  /**
+   * Clear entries older (or newer if _older is false) than given timestamp.
+   *
+   * Without timestamp given, clears all the entries.
+   */
+  void Clear(long _dt = 0, bool _older = true) {
+    if (_dt <= 0) {
+      head = 0;
+      count = 0;
+      return;
+    }
+    if (_older) {
+      int _num = LowerBound(_dt);
+      head = count > 0 ? Pos(_num) : 0;
+      count -= _num;
+    } else {
+      count = UpperBound(_dt);
+    }
+  }
+
+  /* Searching */
+
+  /**
+   * Returns logical index of the first entry with timestamp not less than the given one.
+   */
+  int LowerBound(long _dt) {
+    int _lo = 0, _hi = count;
+    while (_lo < _hi) {
+      int _mid = (_lo + _hi) >> 1;
+      if (times[Pos(_mid)] < _dt) {
+        _lo = _mid + 1;
+      } else {
+        _hi = _mid;
+      }
+    }
+    return _lo;
+  }
+
+  /**
+   * Returns logical index of the first entry with timestamp greater than the given one.
+   */
+  int UpperBound(long _dt) {
+    int _lo = 0, _hi = count;
+    while (_lo < _hi) {
+      int _mid = (_lo + _hi) >> 1;
+      if (times[Pos(_mid)] <= _dt) {
+        _lo = _mid + 1;
+      } else {
+        _hi = _mid;
+      }
+    }
+    return _lo;
+  }
+
+  /**
+   * Returns logical index of entry with given timestamp or -1 if not found.
+   */
+  int IndexOf(long _dt) {
+    int _index = IndexOfNearest(_dt, count - 1);
+    return _index != -1 && times[Pos(_index)] == _dt ? _index : -1;
+  }
+
+  /**
+   * Returns logical index of entry with given timestamp or of the nearest older one, or -1 if there is none.
+   *
+   * Entry at the hinted logical index is checked first, so lookups with a right guess (e.g., the newest entry or the
+   * one derived from shift when there are no gaps in the series) are O(1), the others fall back to binary search.
+   */
+  int IndexOfNearest(long _dt, int _hint = -1) {
+    if (_hint >= 0 && _hint < count && times[Pos(_hint)] == _dt) {
+      return _hint;
+    }
+    return UpperBound(_dt) - 1;
+  }
+
+  /**
+   * Checks whether entry with given timestamp exists.
+   */
+  bool KeyExists(long _dt) { return IndexOf(_dt) != -1; }
+
+  /* Getters */
+
+  /**
+   * Returns entry for a given timestamp.
+   */
+  TStruct GetByKey(long _dt) {
+    int _index = IndexOf(_dt);
+    if (_index == -1) {
+      static TStruct _empty;
+      return _empty;
+    }
+    return items[Pos(_index)];
+  }
+
+  /**
+   * Returns entry for a given timestamp or default value if not found.
+   */
+  TStruct GetByKey(long _dt, TStruct& _default) {
+    int _index = IndexOf(_dt);
+    return _index == -1 ? _default : items[Pos(_index)];
+  }
+
+  /**
+   * Returns entry for a given logical index (0 is the oldest).
+   */
+  TStruct GetByIndex(int _index) {
+    if (_index < 0 || _index >= count) {
+      static TStruct _empty;
+      return _empty;
+    }
+    return items[Pos(_index)];
+  }
+
+  /**
+   * Returns entry for a given shift (0 is the newest).
+   */
+  TStruct GetByShift(int _shift) { return GetByIndex(count - 1 - _shift); }
+
+  /**
+   * Returns timestamp for a given logical index (0 is the oldest).
+   */
+  long GetKeyByIndex(int _index) { return _index >= 0 && _index < count ? times[Pos(_index)] : 0; }
+
+  /**
+   * Returns iterator pointing to the oldest entry.
+   */
+  BufferSeriesIterator<TStruct> Begin() {
+    BufferSeriesIterator<TStruct> _iter(THIS_REF, 0);
+    return _iter;
+  }
+
+  /**
+   * Gets the newest timestamp.
+   */
+  long GetMax() { return count > 0 ? times[Pos(count - 1)] : INT_MIN; }
+
+  /**
+   * Gets the oldest timestamp.
+   */
+  long GetMin() { return count > 0 ? times[head] : INT_MAX; }
+
+  /**
+   * Returns maximum number of entries kept.
+   */
+  int GetCapacity() { return capacity; }
+
+  /**
+   * Returns number of stored entries.
+   */
+  int Size() { return count; }
+
+  /* Setters */
+
+  /**
+   * Sets maximum number of entries kept. Drops the oldest entries when needed.
+   */
+  void SetCapacity(int _capacity) {
+    while (count > _capacity) {
+      PopFront();
+    }
+    if (ArraySize(times) > _capacity) {
+      BufferSeries<TStruct> _copy(THIS_REF);
+      _copy.capacity = _capacity;
+      THIS_REF = _copy;
+    }
+    capacity = _capacity;
+  }
+};
+
+#endif  // BUFFER_SERIES_H
@@ -25,10 +25,15 @@
 #define BUFFER_TICK_H
 
 // Includes.
-#include "../BufferStruct.mqh"
 #include "../Chart.enum.h"
-#include "../Storage/IValueStorage.h"
+#include "../DictStruct.mqh"
+#include "../Storage/ValueStorage.h"
 #include "../Tick.struct.h"
+#include "BufferSeries.h"
+
+// Forward declarations.
+template <typename TV>
+class BufferTick;
 
 template <typename TV>
 class BufferTickValueStorage : ValueStorage<TV> {
@@ -46,25 +51,24 @@ class BufferTickValueStorage : ValueStorage<TV> {
       : buffer_tick(_buffer_tick), applied_price(_applied_price) {}
 
   /**
-   * Fetches value from a given shift. Takes into consideration as-series flag.
+   * Fetches value from a given shift (0 is the newest tick).
    */
   TV Fetch(int _shift) override {
-    Print("BufferTickValueStorage: Fetching " + (applied_price == PRICE_ASK ? "Ask" : "Bid") + " price from shift ",
-          _shift);
-    return 0;
+    TickAB<TV> _tick = buffer_tick PTR_DEREF GetByShift(_shift);
+    return applied_price == PRICE_ASK ? _tick.ask : _tick.bid;
   }
 
   /**
    * Returns number of values available to fetch (size of the values buffer).
    */
-  int Size() const override { return (int)buffer_tick.Size(); }
+  int Size() const override { return buffer_tick PTR_DEREF Size(); }
 };
 
 /**
- * Class to store struct data.
+ * Class to store ticks ordered by their timestamps.
  */
 template <typename TV>
-class BufferTick : public BufferStruct<TickAB<TV>> {
+class BufferTick : public BufferSeries<TickAB<TV>> {
  protected:
   // Ask prices ValueStorage proxy.
   BufferTickValueStorage<TV> *_vs_ask;
@@ -83,7 +87,6 @@ class BufferTick : public BufferStruct<TickAB<TV>> {
   void Init() {
     _vs_ask = NULL;
     _vs_bid = NULL;
-    SetOverflowListener(BufferTickOverflowListener, 10);
   }
 
  public:
@@ -92,7 +95,7 @@ class BufferTick : public BufferStruct<TickAB<TV>> {
   /**
    * Constructor.
    */
-  BufferTick() { Init(); }
+  BufferTick(int _capacity = 86400) : BufferSeries<TickAB<TV>>(_capacity) { Init(); }
   BufferTick(BufferTick &_right) {
     THIS_REF = _right;
     Init();
@@ -145,25 +148,6 @@ class BufferTick : public BufferStruct<TickAB<TV>> {
     // Convert to OHLC in upper method
     return NULL;
   }
-
-  /* Callback methods */
-
-  /**
-   * Function should return true if resize can be made, or false to overwrite current slot.
-   */
-  static bool BufferTickOverflowListener(ENUM_DICT_OVERFLOW_REASON _reason, int _size, int _num_conflicts) {
-    static int cache_limit = 86400;
-    switch (_reason) {
-      case DICT_OVERFLOW_REASON_FULL:
-        // We allow resize if dictionary size is less than 86400 slots.
-        return _size < cache_limit;
-      case DICT_OVERFLOW_REASON_TOO_MANY_CONFLICTS:
-      default:
-        // When there is too many conflicts, we just reject doing resize, so first conflicting slot will be reused.
-        break;
-    }
-    return false;
-  }
 };
 
 #endif  // BUFFER_TICK_H
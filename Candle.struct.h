@@ -241,6 +241,20 @@ struct CandleOCTOHLC : CandleOHLC<T> {
     low = MathMin(low, _price);
   }
 
+  // Updates OHLC values from candle of a shorter timeframe which lies within this one.
+  void Update(const CandleOCTOHLC<T> &_candle) {
+    if (_candle.open_timestamp < open_timestamp) {
+      open_timestamp = _candle.open_timestamp;
+      open = _candle.open;
+    }
+    if (_candle.close_timestamp > close_timestamp) {
+      close_timestamp = _candle.close_timestamp;
+      close = _candle.close;
+    }
+    high = MathMax(high, _candle.high);
+    low = MathMin(low, _candle.low);
+  }
+
   // Returns timestamp of open price.
   long GetOpenTimestamp() { return open_timestamp; }
 
@@ -0,0 +1,77 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Includes external declarations related to chart's history.
+ */
+
+#ifndef __MQL__
+#pragma once
+
+// Includes.
+#include "Chart.enum.h"
+#include "DateTime.extern.h"
+#include "Std.h"
+
+/**
+ * Structure for storing prices, volumes and spread of the bar.
+ * @docs
+ * https://www.mql5.com/en/docs/constants/structures/mqlrates
+ */
+struct MqlRates {
+  datetime time;     // Period start time
+  double open;       // Open price
+  double high;       // The highest price of the period
+  double low;        // The lowest price of the period
+  double close;      // Close price
+  long tick_volume;  // Tick volume
+  int spread;        // Spread
+  long real_volume;  // Trade volume
+};
+
+extern int Bars(string symbol_name, ENUM_TIMEFRAMES timeframe);
+
+extern int CopyRates(string symbol_name, ENUM_TIMEFRAMES timeframe, int start_pos, int count,
+                     ARRAY_REF(MqlRates, rates_array));
+
+extern int CopyOpen(string symbol_name, ENUM_TIMEFRAMES timeframe, int start_pos, int count,
+                    ARRAY_REF(double, open_array));
+
+extern int CopyHigh(string symbol_name, ENUM_TIMEFRAMES timeframe, int start_pos, int count,
+                    ARRAY_REF(double, high_array));
+
+extern int CopyLow(string symbol_name, ENUM_TIMEFRAMES timeframe, int start_pos, int count,
+                   ARRAY_REF(double, low_array));
+
+extern int CopyClose(string symbol_name, ENUM_TIMEFRAMES timeframe, int start_pos, int count,
+                     ARRAY_REF(double, close_array));
+
+extern int CopyTickVolume(string symbol_name, ENUM_TIMEFRAMES timeframe, int start_pos, int count,
+                          ARRAY_REF(long, volume_array));
+
+extern int CopyRealVolume(string symbol_name, ENUM_TIMEFRAMES timeframe, int start_pos, int count,
+                          ARRAY_REF(long, volume_array));
+
+extern int CopySpread(string symbol_name, ENUM_TIMEFRAMES timeframe, int start_pos, int count,
+                      ARRAY_REF(int, spread_array));
+#endif
@@ -0,0 +1,641 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Includes ChartHistory class.
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef CHART_HISTORY_H
+#define CHART_HISTORY_H
+
+// Includes.
+#include "Chart.extern.h"
+#include "Chart.struct.tf.h"
+#include "Storage/ObjectsCache.h"
+#include "Storage/RollingExtremum.h"
+#include "Tick.struct.h"
+#include "Util.h"
+
+// Defines.
+#define CHART_HISTORY_MIN_BARS 256  // Number of the newest bars loaded at first.
+
+/**
+ * Shared cache of the bar history of the given symbol and time-frame.
+ *
+ * Values are kept column by column in chronological order (index 0 is the oldest cached bar), so single values are
+ * read by direct index and ranges are copied straight from the columns. Cache is refreshed at most once per tick:
+ * new bars are appended and the forming bar is patched, both with a single CopyRates() call. Older bars are loaded
+ * on demand, doubling the cached depth. History changed in any other way (e.g., when the oldest bars were dropped)
+ * is reloaded.
+ *
+ * Cached depth is capped by the capacity, i.e., the deepest shift read and the number of bars preloaded for a known
+ * lookback (see Preload()). Once new bars have doubled it, the oldest bars beyond the capacity are dropped.
+ *
+ * Ticks are counted by OnTick() (e.g., on every EA::ProcessTick()), so reading a value costs a comparison of the
+ * counters. Until the first OnTick() call, the last tick of the symbol is checked on every read instead.
+ */
+class ChartHistory {
+ protected:
+  // Symbol and time-frame of the history.
+  string symbol;
+  ENUM_TIMEFRAMES tf;
+  // Values of the cached bars, in chronological order.
+  ARRAY(datetime, times);
+  ARRAY(double, opens);
+  ARRAY(double, highs);
+  ARRAY(double, lows);
+  ARRAY(double, closes);
+  ARRAY(long, tick_volumes);
+  ARRAY(long, volumes);
+  ARRAY(int, spreads);
+  // Number of cached bars.
+  int size;
+  // Number of the newest bars kept when dropping the oldest ones.
+  int capacity;
+  // Number of bars in the history at the last refresh.
+  int bars;
+  // Tick counter value the cache was refreshed on (see OnTick()).
+  unsigned long refresh_ticks;
+  // Last tick the cache was refreshed on.
+  long tick_msc;
+  double tick_bid;
+  double tick_ask;
+  // Rolling windows of GetPeakShift() calls.
+  DictStruct<string, Ref<RollingExtremum<double>>> extrema;
+
+  /* Protected methods */
+
+  /**
+   * Adds given number of ticks to the counter shared by all the histories, then returns its value.
+   */
+  static unsigned long CountTicks(int _count) {
+    static unsigned long _ticks = 0;
+    _ticks += _count;
+    return _ticks;
+  }
+
+  /**
+   * Checks whether the last tick of the symbol has changed since the last call.
+   */
+  bool IsNewTick() {
+    MqlTick _tick;
+    long _tick_msc = 0;
+    // Without the tick, the forming bar can't be told apart from the changed one, so it is always patched.
+    if (!SymbolInfoTick(symbol, _tick)) {
+      tick_msc = 0;
+      tick_bid = 0;
+      tick_ask = 0;
+      return true;
+    }
+#ifdef __MQL4__
+    // MQL4 ticks have no milliseconds.
+    _tick_msc = (long)_tick.time * 1000;
+#else
+    _tick_msc = _tick.time_msc;
+#endif
+    if (_tick_msc == tick_msc && _tick.bid == tick_bid && _tick.ask == tick_ask) {
+      return false;
+    }
+    tick_msc = _tick_msc;
+    tick_bid = _tick.bid;
+    tick_ask = _tick.ask;
+    return true;
+  }
+
+  /**
+   * Resizes all the columns, keeping the oldest bars.
+   */
+  void Resize(int _size) {
+    int _reserve = MathMax(_size / 4, CHART_HISTORY_MIN_BARS);
+    ArrayResize(times, _size, _reserve);
+    ArrayResize(opens, _size, _reserve);
+    ArrayResize(highs, _size, _reserve);
+    ArrayResize(lows, _size, _reserve);
+    ArrayResize(closes, _size, _reserve);
+    ArrayResize(tick_volumes, _size, _reserve);
+    ArrayResize(volumes, _size, _reserve);
+    ArrayResize(spreads, _size, _reserve);
+    size = _size;
+  }
+
+  /**
+   * Drops the oldest cached bars, keeping the given number of the newest ones.
+   */
+  void Trim(int _size) {
+    int _drop = size - _size;
+    if (_drop <= 0) {
+      return;
+    }
+    for (int i = 0; i < _size; ++i) {
+      times[i] = times[_drop + i];
+      opens[i] = opens[_drop + i];
+      highs[i] = highs[_drop + i];
+      lows[i] = lows[_drop + i];
+      closes[i] = closes[_drop + i];
+      tick_volumes[i] = tick_volumes[_drop + i];
+      volumes[i] = volumes[_drop + i];
+      spreads[i] = spreads[_drop + i];
+    }
+    Resize(_size);
+  }
+
+  /**
+   * Sets values of the given number of bars starting from the given index.
+   */
+  void SetRates(int _index, ARRAY_REF(MqlRates, _rates), int _count) {
+    for (int i = 0; i < _count; ++i) {
+      times[_index + i] = _rates[i].time;
+      opens[_index + i] = _rates[i].open;
+      highs[_index + i] = _rates[i].high;
+      lows[_index + i] = _rates[i].low;
+      closes[_index + i] = _rates[i].close;
+      tick_volumes[_index + i] = _rates[i].tick_volume;
+      volumes[_index + i] = _rates[i].real_volume;
+      spreads[_index + i] = _rates[i].spread;
+    }
+  }
+
+  /**
+   * Loads given number of the newest bars, dropping the cached ones.
+   */
+  bool Load(int _count) {
+    ARRAY(MqlRates, _rates);
+    if (_count <= 0 || CopyRates(symbol, tf, 0, _count, _rates) != _count) {
+      Resize(0);
+      return false;
+    }
+    Resize(_count);
+    SetRates(0, _rates, _count);
+    return true;
+  }
+
+  /**
+   * Loads older bars, so the given number of bars is cached.
+   */
+  bool Extend(int _size) {
+    int _count = _size - size;
+    ARRAY(MqlRates, _rates);
+    if (_count <= 0) {
+      return true;
+    }
+    // Oldest cached bar is at the series shift of size - 1, as newer bars are appended on each refresh.
+    if (CopyRates(symbol, tf, size, _count, _rates) != _count ||
+        (size > 0 && (long)_rates[_count - 1].time >= (long)times[0])) {
+      return false;
+    }
+    int _prev_size = size;
+    Resize(_size);
+    for (int i = _prev_size - 1; i >= 0; --i) {
+      times[_count + i] = times[i];
+      opens[_count + i] = opens[i];
+      highs[_count + i] = highs[i];
+      lows[_count + i] = lows[i];
+      closes[_count + i] = closes[i];
+      tick_volumes[_count + i] = tick_volumes[i];
+      volumes[_count + i] = volumes[i];
+      spreads[_count + i] = spreads[i];
+    }
+    SetRates(0, _rates, _count);
+    return true;
+  }
+
+  /**
+   * Returns index of the oldest cached bar opened at or after the given time (size if there is no such bar).
+   */
+  int LowerBound(datetime _time) {
+    int _lo = 0, _hi = size;
+    while (_lo < _hi) {
+      int _mid = (_lo + _hi) / 2;
+      if ((long)times[_mid] < (long)_time) {
+        _lo = _mid + 1;
+      } else {
+        _hi = _mid;
+      }
+    }
+    return _lo;
+  }
+
+  /**
+   * Returns value of the given applied price of the cached bar.
+   */
+  double GetPriceByIndex(ENUM_APPLIED_PRICE _ap, int _index) {
+    switch (_ap) {
+      case PRICE_OPEN:
+        return opens[_index];
+      case PRICE_HIGH:
+        return highs[_index];
+      case PRICE_LOW:
+        return lows[_index];
+      case PRICE_CLOSE:
+        return closes[_index];
+      case PRICE_MEDIAN:
+        return (highs[_index] + lows[_index]) / 2;
+      case PRICE_TYPICAL:
+        return (highs[_index] + lows[_index] + closes[_index]) / 3;
+      case PRICE_WEIGHTED:
+        return (highs[_index] + lows[_index] + (2 * closes[_index])) / 4;
+    }
+    return 0;
+  }
+
+  /**
+   * Returns value of the given series mode (e.g., MODE_HIGH) of the cached bar.
+   */
+  double GetSeriesValueByIndex(int _mode, int _index) {
+    switch (_mode) {
+      case MODE_OPEN:
+        return opens[_index];
+      case MODE_LOW:
+        return lows[_index];
+      case MODE_HIGH:
+        return highs[_index];
+      case MODE_CLOSE:
+        return closes[_index];
+      case MODE_VOLUME:
+        return (double)tick_volumes[_index];
+      case MODE_TIME:
+        return (double)(long)times[_index];
+    }
+    return 0;
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  ChartHistory(string _symbol = NULL, ENUM_TIMEFRAMES _tf = PERIOD_CURRENT)
+      : symbol(StringLen(_symbol) > 0 ? _symbol : _Symbol),
+        tf(_tf),
+        size(0),
+        capacity(CHART_HISTORY_MIN_BARS),
+        bars(0),
+        refresh_ticks(0),
+        tick_msc(0),
+        tick_bid(0),
+        tick_ask(0) {}
+
+  /**
+   * Returns pointer to the shared history of a given symbol and time-frame.
+   */
+  static ChartHistory *GetInstance(string _symbol, ENUM_TIMEFRAMES _tf) {
+    ChartHistory *_history;
+    // Same series is shared no matter how it is referred to (e.g., NULL or PERIOD_CURRENT).
+    _symbol = StringLen(_symbol) > 0 ? _symbol : _Symbol;
+    ENUM_TIMEFRAMES_INDEX _tfi = ChartTf::TfToIndex(_tf);
+    _tf = _tfi != FINAL_ENUM_TIMEFRAMES_INDEX ? ChartTf::IndexToTf(_tfi) : _tf;
+    string _key = Util::MakeKey(_symbol, (int)_tf);
+    if (!ObjectsCache<ChartHistory>::TryGet(_key, _history)) {
+      _history = ObjectsCache<ChartHistory>::Set(_key, new ChartHistory(_symbol, _tf));
+    }
+    return _history;
+  }
+
+  /**
+   * Notifies all the histories of a new tick, so each one is refreshed once on its next read.
+   *
+   * Call it once per tick, before reading the history.
+   */
+  static void OnTick() { CountTicks(1); }
+
+  /* Getters */
+
+  /**
+   * Returns number of ticks counted by OnTick().
+   */
+  static unsigned long GetTicks() { return CountTicks(0); }
+
+  /**
+   * Returns symbol of the history.
+   */
+  string GetSymbol() { return symbol; }
+
+  /**
+   * Returns time-frame of the history.
+   */
+  ENUM_TIMEFRAMES GetTf() { return tf; }
+
+  /**
+   * Returns number of bars in the history at the last refresh.
+   */
+  int GetBars() { return bars; }
+
+  /**
+   * Returns number of cached bars.
+   */
+  int Size() { return size; }
+
+  /**
+   * Returns number of the newest bars kept when dropping the oldest ones.
+   */
+  int GetCapacity() { return capacity; }
+
+  /**
+   * Returns index of the cached bar at the given series shift or -1 if there is no such bar.
+   *
+   * Refreshes the cache on a new tick and loads older bars when needed.
+   */
+  int GetIndex(int _shift) {
+    Refresh();
+    if (_shift < 0 || _shift >= bars) {
+      return -1;
+    }
+    capacity = MathMax(capacity, _shift + 1);
+    if (_shift >= size && !Extend(MathMin(MathMax(size * 2, _shift + 1), bars))) {
+      return -1;
+    }
+    return size - 1 - _shift;
+  }
+
+  /**
+   * Loads older bars at once, so the given number of the newest bars (up to all the bars in the history) is cached.
+   *
+   * Useful when the number of bars needed is known upfront (e.g., backfill range extended by the lookback), as
+   * GetIndex() grows the cache step by step otherwise.
+   */
+  bool Preload(int _count) {
+    Refresh();
+    capacity = MathMax(capacity, _count);
+    return Extend(MathMin(_count, bars));
+  }
+
+  /**
+   * Searches for a bar by its time with a binary search over the cached bar times.
+   *
+   * Older bars are loaded until the given time is covered. Results match the former CopyTime()-based lookup: the
+   * oldest bar opened at or after the given time, except of time within the newest bar, which is matched by the bar
+   * before it. In exact mode, only the bar opened at the given time is matched.
+   *
+   * @return
+   *   Returns series shift of the bar or -1 if there is no such bar.
+   */
+  int GetBarShift(datetime _time, bool _exact = false) {
+    Refresh();
+    if ((long)_time < 0) {
+      return -1;
+    }
+    while (size < bars && (size == 0 || (long)times[0] > (long)_time)) {
+      if (!Extend(MathMin(MathMax(size * 2, CHART_HISTORY_MIN_BARS), bars))) {
+        return -1;
+      }
+    }
+    if (size == 0) {
+      return -1;
+    }
+    // Number of bars opened at or after the given time.
+    int _count = size - LowerBound(_time);
+    if (_exact) {
+      return _count > 0 && (long)times[size - _count] == (long)_time ? _count - 1 : -1;
+    }
+    if (_count > 2) {
+      return _count - 1;
+    }
+    return size > 1 && (long)_time < (long)times[size - 1] ? 1 : 0;
+  }
+
+  /**
+   * Returns open time of the bar or 0 if there is no such bar.
+   */
+  datetime GetTime(int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? times[_index] : (datetime)0;
+  }
+
+  /**
+   * Returns open price of the bar or 0 if there is no such bar.
+   */
+  double GetOpen(int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? opens[_index] : 0;
+  }
+
+  /**
+   * Returns high price of the bar or 0 if there is no such bar.
+   */
+  double GetHigh(int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? highs[_index] : 0;
+  }
+
+  /**
+   * Returns low price of the bar or 0 if there is no such bar.
+   */
+  double GetLow(int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? lows[_index] : 0;
+  }
+
+  /**
+   * Returns close price of the bar or 0 if there is no such bar.
+   */
+  double GetClose(int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? closes[_index] : 0;
+  }
+
+  /**
+   * Returns applied price of the bar or 0 if there is no such bar.
+   */
+  double GetPrice(ENUM_APPLIED_PRICE _ap, int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? GetPriceByIndex(_ap, _index) : 0;
+  }
+
+  /**
+   * Returns tick volume of the bar or 0 if there is no such bar.
+   */
+  long GetTickVolume(int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? tick_volumes[_index] : 0;
+  }
+
+  /**
+   * Returns trade volume of the bar or 0 if there is no such bar.
+   */
+  long GetVolume(int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? volumes[_index] : 0;
+  }
+
+  /**
+   * Returns spread of the bar or 0 if there is no such bar.
+   */
+  int GetSpread(int _shift) {
+    int _index = GetIndex(_shift);
+    return _index >= 0 ? spreads[_index] : 0;
+  }
+
+  /**
+   * Copies applied prices of the given number of bars starting from the given series shift.
+   *
+   * As Copy*() functions do, values are copied in chronological order.
+   *
+   * @return
+   *   Returns number of copied values or -1 if range exceeds the history.
+   */
+  int GetPrices(ENUM_APPLIED_PRICE _ap, int _shift, int _count, ARRAY_REF(double, _out)) {
+    // Index of the oldest bar of the range.
+    int _index = _shift >= 0 && _count > 0 ? GetIndex(_shift + _count - 1) : -1;
+    if (_index < 0) {
+      return -1;
+    }
+    ArrayResize(_out, _count);
+    switch (_ap) {
+      case PRICE_OPEN:
+        return ArrayCopy(_out, opens, 0, _index, _count);
+      case PRICE_HIGH:
+        return ArrayCopy(_out, highs, 0, _index, _count);
+      case PRICE_LOW:
+        return ArrayCopy(_out, lows, 0, _index, _count);
+      case PRICE_CLOSE:
+        return ArrayCopy(_out, closes, 0, _index, _count);
+    }
+    for (int i = 0; i < _count; ++i) {
+      _out[i] = GetPriceByIndex(_ap, _index + i);
+    }
+    return _count;
+  }
+
+  /**
+   * Copies open times of the given number of bars starting from the given series shift, in chronological order.
+   *
+   * @return
+   *   Returns number of copied values or -1 if range exceeds the history.
+   */
+  int GetTimes(int _shift, int _count, ARRAY_REF(datetime, _out)) {
+    int _index = _shift >= 0 && _count > 0 ? GetIndex(_shift + _count - 1) : -1;
+    if (_index < 0) {
+      return -1;
+    }
+    ArrayResize(_out, _count);
+    return ArrayCopy(_out, times, 0, _index, _count);
+  }
+
+  /**
+   * Copies tick volumes of the given number of bars starting from the given series shift, in chronological order.
+   *
+   * @return
+   *   Returns number of copied values or -1 if range exceeds the history.
+   */
+  int GetTickVolumes(int _shift, int _count, ARRAY_REF(long, _out)) {
+    int _index = _shift >= 0 && _count > 0 ? GetIndex(_shift + _count - 1) : -1;
+    if (_index < 0) {
+      return -1;
+    }
+    ArrayResize(_out, _count);
+    return ArrayCopy(_out, tick_volumes, 0, _index, _count);
+  }
+
+  /**
+   * Returns series shift of the highest or the lowest value of the given series mode (e.g., MODE_HIGH) over the given
+   * number of bars (WHOLE_ARRAY for all) starting from the given shift, or -1 if there are no such bars.
+   *
+   * Window is kept between calls for each mode, count and type, so calling it on every tick for the same bars or for
+   * the next bar costs amortised O(1) instead of copying and scanning the whole range. Other calls rebuild the window.
+   */
+  int GetPeakShift(ENUM_IPEAK _type, int _mode, int _count, int _shift) {
+    int _index = _shift >= 0 && _count != 0 ? GetIndex(_shift) : -1;
+    if (_index < 0) {
+      return -1;
+    }
+    // Range is clipped to the history, as Copy*() functions do.
+    bool _whole = _count < 0 || _count >= bars - _shift;
+    _count = _whole ? bars - _shift : _count;
+    if (GetIndex(_shift + _count - 1) < 0) {
+      return -1;
+    }
+    // Cache might have been extended, so index is taken again.
+    _index = size - 1 - _shift;
+    if (_whole) {
+      // Window would grow with every new bar, so the whole range is scanned instead.
+      int _peak = _index;
+      for (int i = _index - 1; i > _index - _count; --i) {
+        double _value = GetSeriesValueByIndex(_mode, i);
+        if (_type == IPEAK_HIGHEST ? _value > GetSeriesValueByIndex(_mode, _peak)
+                                   : _value < GetSeriesValueByIndex(_mode, _peak)) {
+          _peak = i;
+        }
+      }
+      return _shift + _index - _peak;
+    }
+    string _key = IntegerToString(_mode) + ":" + IntegerToString(_count) + (_type == IPEAK_HIGHEST ? ":H" : ":L");
+    Ref<RollingExtremum<double>> _ref = extrema.GetByKey(_key);
+    if (!_ref.IsSet()) {
+      _ref = new RollingExtremum<double>(_count, _type);
+      extrema.Set(_key, _ref);
+    }
+    RollingExtremum<double>* _window = _ref.Ptr();
+    int _push = _window PTR_DEREF Seek(_index > 0 ? (long)times[_index - 1] : 0,
+                                       _index > 1 ? (long)times[_index - 2] : 0);
+    for (int i = _index - _push; i < _index; ++i) {
+      _window PTR_DEREF Append(GetSeriesValueByIndex(_mode, i), (long)times[i]);
+    }
+    return _shift + _window PTR_DEREF PeekShift(GetSeriesValueByIndex(_mode, _index));
+  }
+
+  /* Modifiers */
+
+  /**
+   * Synchronizes the cache with the history.
+   *
+   * Does nothing when there was no new tick since the last refresh (see OnTick()), unless forced.
+   *
+   * @return
+   *   Returns false if history couldn't be copied.
+   */
+  bool Refresh(bool _force = false) {
+    unsigned long _ticks = GetTicks();
+    bool _is_new_tick = _ticks > 0 ? _ticks != refresh_ticks : IsNewTick();
+    if (!_force && size > 0 && !_is_new_tick) {
+      return true;
+    }
+    refresh_ticks = _ticks;
+    int _bars = Bars(symbol, tf);
+
+    // Number of bars formed since the last refresh.
+    int _new = _bars - bars;
+    bars = _bars;
+    if (size > 0 && _new >= 0 && _new < size) {
+      // Bar forming at the last refresh is copied again along with the new ones.
+      ARRAY(MqlRates, _rates);
+      if (CopyRates(symbol, tf, 0, _new + 1, _rates) == _new + 1 && (long)_rates[0].time == (long)times[size - 1]) {
+        int _index = size - 1;
+        Resize(size + _new);
+        SetRates(_index, _rates, _new + 1);
+        if (size >= capacity * 2) {
+          // Bars are dropped in batches, so it costs amortised O(1) per new bar.
+          Trim(capacity);
+        }
+        return true;
+      }
+    }
+    return Load(MathMin(MathMax(size, CHART_HISTORY_MIN_BARS), bars));
+  }
+};
+
+#endif  // CHART_HISTORY_H
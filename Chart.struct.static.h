@@ -25,6 +25,9 @@
  * Includes Chart's static structs.
  */
 
+// Includes.
+#include "Chart.history.h"
+
 /* Defines struct for chart static methods. */
 struct ChartStatic {
   /**
@@ -49,21 +52,19 @@ struct ChartStatic {
 #ifdef __MQL4__
     return ::iBarShift(_symbol, _tf, _time, _exact);
 #else  // __MQL5__
-    if (_time < 0) return (-1);
-    ARRAY(datetime, arr);
-    datetime _time0;
-    // ENUM_TIMEFRAMES _tf = MQL4::TFMigrate(_tf);
-    CopyTime(_symbol, _tf, 0, 1, arr);
-    _time0 = arr[0];
-    if (CopyTime(_symbol, _tf, _time, _time0, arr) > 0) {
-      if (ArraySize(arr) > 2) {
-        return ArraySize(arr) - 1;
-      } else {
-        return _time < _time0 ? 1 : 0;
-      }
-    } else {
-      return -1;
-    }
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetBarShift(_time, _exact);
+#endif
+  }
+
+  /**
+   * Loads the given number of the newest bars at once, when the number of bars needed is known upfront.
+   */
+  static bool PreloadBars(string _symbol, ENUM_TIMEFRAMES _tf, int _count) {
+#ifdef __MQL4__
+    // History is accessed directly.
+    return true;
+#else  // __MQL5__
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF Preload(_count);
 #endif
   }
 
@@ -78,9 +79,7 @@ struct ChartStatic {
 #ifdef __MQL4__
     return ::iClose(_symbol, _tf, _shift);  // Same as: Close[_shift]
 #else                                       // __MQL5__
-    ARRAY(double, _arr);
-    ArraySetAsSeries(_arr, true);
-    return (_shift >= 0 && CopyClose(_symbol, _tf, _shift, 1, _arr) > 0) ? _arr[0] : 0;
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetClose(_shift);
 #endif
   }
 
@@ -93,9 +92,7 @@ struct ChartStatic {
 #ifdef __MQL4__
     return ::iHigh(_symbol, _tf, _shift);  // Same as: High[_shift]
 #else                                      // __MQL5__
-    ARRAY(double, _arr);
-    ArraySetAsSeries(_arr, true);
-    return (_shift >= 0 && CopyHigh(_symbol, _tf, _shift, 1, _arr) > 0) ? _arr[0] : 0;
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetHigh(_shift);
 #endif
   }
 
@@ -109,35 +106,7 @@ struct ChartStatic {
 #else  // __MQL5__
     if (_start < 0) return (-1);
     _count = (_count <= 0 ? ChartStatic::iBars(_symbol, _tf) : _count);
-    ARRAY(double, arr_d);
-    ARRAY(long, arr_l);
-    ARRAY(datetime, arr_dt);
-    ArraySetAsSeries(arr_d, true);
-    switch (_type) {
-      case MODE_OPEN:
-        CopyOpen(_symbol, _tf, _start, _count, arr_d);
-        break;
-      case MODE_LOW:
-        CopyLow(_symbol, _tf, _start, _count, arr_d);
-        break;
-      case MODE_HIGH:
-        CopyHigh(_symbol, _tf, _start, _count, arr_d);
-        break;
-      case MODE_CLOSE:
-        CopyClose(_symbol, _tf, _start, _count, arr_d);
-        break;
-      case MODE_VOLUME:
-        ArraySetAsSeries(arr_l, true);
-        CopyTickVolume(_symbol, _tf, _start, _count, arr_l);
-        return (ArrayMaximum(arr_l, 0, _count) + _start);
-      case MODE_TIME:
-        ArraySetAsSeries(arr_dt, true);
-        CopyTime(_symbol, _tf, _start, _count, arr_dt);
-        return (ArrayMaximum(arr_dt, 0, _count) + _start);
-      default:
-        break;
-    }
-    return (ArrayMaximum(arr_d, 0, _count) + _start);
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetPeakShift(IPEAK_HIGHEST, _type, (int)_count, _start);
 #endif
   }
 
@@ -150,9 +119,7 @@ struct ChartStatic {
 #ifdef __MQL4__
     return ::iLow(_symbol, _tf, _shift);  // Same as: Low[_shift]
 #else                                     // __MQL5__
-    ARRAY(double, _arr);
-    ArraySetAsSeries(_arr, true);
-    return (_shift >= 0 && CopyLow(_symbol, _tf, _shift, 1, _arr) > 0) ? _arr[0] : 0;
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetLow(_shift);
 #endif
   }
 
@@ -166,35 +133,7 @@ struct ChartStatic {
 #else  // __MQL5__
     if (_start < 0) return (-1);
     _count = (_count <= 0 ? iBars(_symbol, _tf) : _count);
-    ARRAY(double, arr_d);
-    ARRAY(long, arr_l);
-    ARRAY(datetime, arr_dt);
-    ArraySetAsSeries(arr_d, true);
-    switch (_type) {
-      case MODE_OPEN:
-        CopyOpen(_symbol, _tf, _start, _count, arr_d);
-        break;
-      case MODE_LOW:
-        CopyLow(_symbol, _tf, _start, _count, arr_d);
-        break;
-      case MODE_HIGH:
-        CopyHigh(_symbol, _tf, _start, _count, arr_d);
-        break;
-      case MODE_CLOSE:
-        CopyClose(_symbol, _tf, _start, _count, arr_d);
-        break;
-      case MODE_VOLUME:
-        ArraySetAsSeries(arr_l, true);
-        CopyTickVolume(_symbol, _tf, _start, _count, arr_l);
-        return ArrayMinimum(arr_l, 0, _count) + _start;
-      case MODE_TIME:
-        ArraySetAsSeries(arr_dt, true);
-        CopyTime(_symbol, _tf, _start, _count, arr_dt);
-        return ArrayMinimum(arr_dt, 0, _count) + _start;
-      default:
-        break;
-    }
-    return ArrayMinimum(arr_d, 0, _count) + _start;
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetPeakShift(IPEAK_LOWEST, _type, (int)_count, _start);
 #endif
   }
 
@@ -207,9 +146,7 @@ struct ChartStatic {
 #ifdef __MQL4__
     return ::iOpen(_symbol, _tf, _shift);  // Same as: Open[_shift]
 #else                                      // __MQL5__
-    ARRAY(double, _arr);
-    ArraySetAsSeries(_arr, true);
-    return (_shift >= 0 && CopyOpen(_symbol, _tf, _shift, 1, _arr) > 0) ? _arr[0] : 0;
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetOpen(_shift);
 #endif
   }
 
@@ -265,10 +202,7 @@ struct ChartStatic {
 #ifdef __MQL4__
     return ::iTime(_symbol, _tf, _shift);  // Same as: Time[_shift]
 #else                                      // __MQL5__
-    ARRAY(datetime, _arr);
-    // ENUM_TIMEFRAMES _tf = MQL4::TFMigrate(_tf);
-    // @todo: Improves performance by caching values.
-    return (_shift >= 0 && ::CopyTime(_symbol, _tf, _shift, 1, _arr) > 0) ? _arr[0] : 0;
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetTime(_shift);
 #endif
   }
 
@@ -287,9 +221,7 @@ struct ChartStatic {
     }
     return _volume;
 #else  // __MQL5__
-    ARRAY(long, _arr);
-    ArraySetAsSeries(_arr, true);
-    return (_shift >= 0 && CopyTickVolume(_symbol, _tf, _shift, 1, _arr) > 0) ? _arr[0] : 0;
+    return ChartHistory::GetInstance(_symbol, _tf) PTR_DEREF GetTickVolume(_shift);
 #endif
   }
 
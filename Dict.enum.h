@@ -30,9 +30,15 @@
 #pragma once
 #endif
 
-#define DICT_GROW_UP_PERCENT_DEFAULT 25
+#define DICT_GROW_UP_PERCENT_DEFAULT 100
 #define DICT_PERFORMANCE_PROBLEM_AVG_CONFLICTS 10
 
+// Minimum number of slots allocated by a dictionary. Number of slots is always a power of two.
+#define DICT_MIN_SLOTS 16
+
+// Maximum percentage of used and removed slots before slots are rehashed.
+#define DICT_MAX_LOAD_PERCENT 75
+
 /**
  * Whether Dict operates in yet uknown mode, as dict or as list.
  */
@@ -49,6 +49,9 @@ struct DictSlotsRef {
 
   int _num_used;
 
+  // Number of removed slots (tombstones) which still take part in probing.
+  int _num_deleted;
+
   int _num_conflicts;
 
   float _avg_conflicts;
@@ -56,6 +59,7 @@ struct DictSlotsRef {
   DictSlotsRef() {
     _list_index = 0;
     _num_used = 0;
+    _num_deleted = 0;
     _num_conflicts = 0;
     _avg_conflicts = 0;
   }
@@ -64,6 +68,7 @@ struct DictSlotsRef {
     Util::ArrayCopy(DictSlots, r.DictSlots);
     _list_index = r._list_index;
     _num_used = r._num_used;
+    _num_deleted = r._num_deleted;
     _num_conflicts = r._num_conflicts;
     _avg_conflicts = r._avg_conflicts;
   }
@@ -31,6 +31,9 @@ extern bool FileIsExist(const string file_name, int common_flag = 0);
 extern int FileClose(int file_handle);
 extern int FileOpen(string file_name, int open_flags, short delimiter = '\t', unsigned int codepage = CP_ACP);
 extern int FileReadInteger(int file_handle, int size = INT_VALUE);
+extern long FileReadLong(int file_handle);
 extern string FileReadString(int file_handle, int length = -1);
+extern unsigned int FileWriteInteger(int file_handle, int value, int size = INT_VALUE);
+extern unsigned int FileWriteLong(int file_handle, long value);
 extern unsigned int FileWriteString(int file_handle, const string text_string, int length = -1);
 #endif
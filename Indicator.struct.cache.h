@@ -31,6 +31,7 @@
 #endif
 
 // Includes.
+#include "Indicator/IndicatorKeyDict.h"
 #include "Refs.mqh"
 #include "Storage/ValueStorage.h"
 
@@ -70,6 +71,12 @@ class IndicatorCalculateCache : public Dynamic {
   // Auxiliary caches related to this one.
   ARRAY(IndicatorCalculateCache<C> *, subcaches);
 
+  // Calculation states (e.g., rolling windows) carried between OnCalculate calls.
+  ARRAY(Dynamic *, states);
+
+  // Ids of indicators which calculated their values using this cache (see IndicatorCalculateCaches::SetUser()).
+  ARRAY(long, users);
+
   /**
    * Constructor.
    */
@@ -97,6 +104,8 @@ class IndicatorCalculateCache : public Dynamic {
         delete subcaches[i];
       }
     }
+
+    ClearStates();
   }
 
   /**
@@ -119,6 +128,34 @@ class IndicatorCalculateCache : public Dynamic {
    */
   int NumBuffers() { return ArraySize(buffers); }
 
+  /**
+   * Whether cache holds anything besides the plain calculation buffers, so it can't be restored from them alone.
+   */
+  bool HasStates() { return ArraySize(states) != 0 || ArraySize(subcaches) != 0; }
+
+  /**
+   * Checks whether cache was used by the given indicator.
+   */
+  bool HasUser(long _user) {
+    for (int i = 0; i < ArraySize(users); ++i) {
+      if (users[i] == _user) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Marks cache as used by the given indicator.
+   */
+  void AddUser(long _user) {
+    if (!HasUser(_user)) {
+      int _size = ArraySize(users);
+      ArrayResize(users, _size + 1, 4);
+      users[_size] = _user;
+    }
+  }
+
   /**
    * Returns existing or new cache as a child of current one. Useful when indicator uses other indicators and requires
    * unique caches for them.
@@ -135,6 +172,36 @@ class IndicatorCalculateCache : public Dynamic {
     return subcaches[index];
   }
 
+  /**
+   * Returns existing or new calculation state of the given type. Usage: GetState<RollingExtremum<double>>(0)
+   *
+   * States are dropped when prev_calculated is reset, so kernels always start from the clean ones.
+   */
+  template <typename T>
+  T *GetState(int _index) {
+    if (_index >= ArraySize(states)) {
+      ArrayResize(states, _index + 1, 10);
+    }
+
+    if (states[_index] == NULL) {
+      states[_index] = new T();
+    }
+
+    return (T *)states[_index];
+  }
+
+  /**
+   * Deletes all calculation states.
+   */
+  void ClearStates() {
+    for (int i = 0; i < ArraySize(states); ++i) {
+      if (states[i] != NULL) {
+        delete states[i];
+        states[i] = NULL;
+      }
+    }
+  }
+
   /**
    * Add buffer of the given type. Usage: AddBuffer<NativeBuffer>()
    */
@@ -218,10 +285,13 @@ class IndicatorCalculateCache : public Dynamic {
 
   /**
    * Resizes all buffers.
+   *
+   * @param _reserve_size
+   *   Number of additional values to preallocate. Buffers hold exactly the given size by default.
    */
-  void Resize(int _buffers_size) {
+  void Resize(int _buffers_size, int _reserve_size = 0) {
     for (int i = 0; i < ArraySize(buffers); ++i) {
-      buffers[i].Resize(_buffers_size, 65535);
+      buffers[i].Resize(_buffers_size, _reserve_size);
     }
   }
 
@@ -257,10 +327,115 @@ class IndicatorCalculateCache : public Dynamic {
   /**
    * Resets prev_calculated value used by indicator's OnCalculate method.
    */
-  void ResetPrevCalculated() { prev_calculated = 0; }
+  void ResetPrevCalculated() {
+    prev_calculated = 0;
+    ClearStates();
+  }
 
   /**
    * Returns prev_calculated value used by indicator's OnCalculate method.
    */
   int GetPrevCalculated(int _prev_calculated) { return prev_calculated; }
 };
+
+/**
+ * Holds caches of indicators calculated via OnCalculate methods by their typed keys (see
+ * INDICATOR_CALCULATE_POPULATE_CACHE).
+ *
+ * Caches are marked with the indicator calculating its values at the time they are requested (see SetUser()), so
+ * caches of the given indicator can be saved and restored (see IndicatorFileCache).
+ */
+class IndicatorCalculateCaches {
+ protected:
+  // Caches by their keys.
+  IndicatorKeyDict<IndicatorCalculateCache<double>> caches;
+  // Id of the indicator currently calculating its values or 0 if none.
+  long user;
+  // Last id returned by NewUser().
+  long last_user;
+
+  /**
+   * Returns the instance.
+   */
+  static IndicatorCalculateCaches *GetInstance() {
+    static IndicatorCalculateCaches _instance;
+    return &_instance;
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  IndicatorCalculateCaches() : user(0), last_user(0) {}
+
+  /**
+   * Returns existing or new cache registered with the given key.
+   */
+  static IndicatorCalculateCache<double> *GetByKey(IndicatorParamsKey &_key) {
+    IndicatorCalculateCaches *_instance = GetInstance();
+    int _index = _instance PTR_DEREF caches.Add(_key);
+    IndicatorCalculateCache<double> *_cache = _instance PTR_DEREF caches.GetByIndex(_index);
+    if (_cache == NULL) {
+      _cache = new IndicatorCalculateCache<double>();
+      _instance PTR_DEREF caches.SetByIndex(_index, _cache);
+    }
+    if (_instance PTR_DEREF user != 0) {
+      _cache PTR_DEREF AddUser(_instance PTR_DEREF user);
+    }
+    return _cache;
+  }
+
+  /**
+   * Returns cache registered with the given key or NULL if there's none.
+   */
+  static IndicatorCalculateCache<double> *Find(IndicatorParamsKey &_key) {
+    IndicatorCalculateCaches *_instance = GetInstance();
+    int _index = _instance PTR_DEREF caches.Find(_key);
+    return _index != -1 ? _instance PTR_DEREF caches.GetByIndex(_index) : NULL;
+  }
+
+  /**
+   * Returns number of registered keys (including ones of the dropped caches).
+   */
+  static int Size() { return GetInstance() PTR_DEREF caches.Size(); }
+
+  /**
+   * Returns cache of the given index or NULL if it was dropped.
+   */
+  static IndicatorCalculateCache<double> *GetByIndex(int _index) {
+    return GetInstance() PTR_DEREF caches.GetByIndex(_index);
+  }
+
+  /**
+   * Returns key of the cache of the given index.
+   */
+  static IndicatorParamsKey GetKeyByIndex(int _index) { return GetInstance() PTR_DEREF caches.GetKeyByIndex(_index); }
+
+  /**
+   * Returns new id to mark caches used by an indicator with.
+   */
+  static long NewUser() { return ++GetInstance() PTR_DEREF last_user; }
+
+  /**
+   * Sets id of the indicator which is about to calculate its values.
+   *
+   * @return
+   *   Returns id of the previous one, to be set back once calculation is done.
+   */
+  static long SetUser(long _user) {
+    IndicatorCalculateCaches *_instance = GetInstance();
+    long _prev = _instance PTR_DEREF user;
+    _instance PTR_DEREF user = _user;
+    return _prev;
+  }
+
+  /**
+   * Drops all the caches, so values are calculated from scratch (e.g., as on the fresh start).
+   */
+  static void Reset() {
+    IndicatorCalculateCaches *_instance = GetInstance();
+    for (int i = 0; i < _instance PTR_DEREF caches.Size(); ++i) {
+      _instance PTR_DEREF caches.SetByIndex(i, NULL);
+    }
+  }
+};
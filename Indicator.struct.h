@@ -44,6 +44,7 @@ struct ChartParams;
 #include "Data.struct.h"
 #include "DateTime.struct.h"
 #include "Indicator.enum.h"
+#include "Indicator.struct.key.h"
 #include "SerializerNode.enum.h"
 
 /* Structure for indicator parameters. */
@@ -109,6 +110,32 @@ struct IndicatorParams {
   int GetShift() const { return shift; }
   ENUM_INDICATOR_TYPE GetIndicatorType() { return itype; }
   ENUM_TIMEFRAMES GetTf() const { return tf.GetTf(); }
+  /**
+   * Adds params to the key identifying structurally equal indicators.
+   *
+   * @return
+   *   Returns false, as params specific to the indicator aren't known here. Params struct of indicator which may be
+   *   shared has to hide this method, add its own params and return true.
+   */
+  bool GetKey(IndicatorParamsKey &_key) {
+    _key.AddInteger(itype);
+    _key.AddInteger(GetTf());
+    _key.AddInteger(shift);
+    _key.AddString(custom_indi_name);
+    for (int i = 0; i < ArraySize(input_params); ++i) {
+      _key.AddInteger(input_params[i].type);
+      _key.AddInteger(input_params[i].integer_value);
+      _key.AddDouble(input_params[i].double_value);
+      _key.AddString(input_params[i].string_value);
+    }
+    return false;
+  }
+  /**
+   * Returns minimum number of bars of the data source needed to calculate value of a single bar.
+   *
+   * Params struct of indicator which looks back further than the current bar has to hide this method.
+   */
+  int GetLookback() { return 1; }
   template <typename T>
   T GetInputParam(int _index, T _default) const {
     DataParamEntry _param = input_params[_index];
@@ -0,0 +1,289 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Includes IndicatorParamsKey struct.
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Includes.
+#include "DictBase.mqh"
+
+/**
+ * Typed key identifying structurally equal indicators (same type, params and data source).
+ *
+ * Params are added one by one with their types kept, so keys are compared value by value instead of building and
+ * comparing strings. 64-bit hash of the values is updated as they're added.
+ */
+struct IndicatorParamsKey {
+ protected:
+  // Integer values and bit patterns of floating-point values.
+  ARRAY(long, values);
+  ARRAY(string, strings);
+  unsigned long hash;
+
+  /**
+   * Mixes value into the hash.
+   */
+  void Mix(unsigned long _value) {
+    _value ^= _value >> 30;
+    _value *= 0xbf58476d1ce4e5b9;
+    _value ^= _value >> 27;
+    _value *= 0x94d049bb133111eb;
+    _value ^= _value >> 31;
+    hash = (hash ^ _value) * 0x100000001b3;
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  IndicatorParamsKey() : hash(0xcbf29ce484222325) {}
+  IndicatorParamsKey(const IndicatorParamsKey &_key) { Copy(_key); }
+
+  /**
+   * Assignment operator.
+   */
+  void operator=(const IndicatorParamsKey &_key) { Copy(_key); }
+
+  /**
+   * Copies values and hash of another key.
+   */
+  void Copy(const IndicatorParamsKey &_key) {
+    ArrayResize(values, ArraySize(_key.values));
+    for (int i = 0; i < ArraySize(_key.values); ++i) {
+      values[i] = _key.values[i];
+    }
+    ArrayResize(strings, ArraySize(_key.strings));
+    for (int i = 0; i < ArraySize(_key.strings); ++i) {
+      strings[i] = _key.strings[i];
+    }
+    hash = _key.hash;
+  }
+
+  /**
+   * Creates key of the given values.
+   */
+  template <typename A>
+  static IndicatorParamsKey Make(const A _a) {
+    IndicatorParamsKey _key;
+    _key.Add(_a);
+    return _key;
+  }
+
+  /**
+   * Creates key of the given values.
+   */
+  template <typename A, typename B>
+  static IndicatorParamsKey Make(const A _a, const B _b) {
+    IndicatorParamsKey _key = Make(_a);
+    _key.Add(_b);
+    return _key;
+  }
+
+  /**
+   * Creates key of the given values.
+   */
+  template <typename A, typename B, typename C>
+  static IndicatorParamsKey Make(const A _a, const B _b, const C _c) {
+    IndicatorParamsKey _key = Make(_a, _b);
+    _key.Add(_c);
+    return _key;
+  }
+
+  /**
+   * Creates key of the given values.
+   */
+  template <typename A, typename B, typename C, typename D>
+  static IndicatorParamsKey Make(const A _a, const B _b, const C _c, const D _d) {
+    IndicatorParamsKey _key = Make(_a, _b, _c);
+    _key.Add(_d);
+    return _key;
+  }
+
+  /**
+   * Creates key of the given values.
+   */
+  template <typename A, typename B, typename C, typename D, typename E>
+  static IndicatorParamsKey Make(const A _a, const B _b, const C _c, const D _d, const E _e) {
+    IndicatorParamsKey _key = Make(_a, _b, _c, _d);
+    _key.Add(_e);
+    return _key;
+  }
+
+  /**
+   * Creates key of the given values.
+   */
+  template <typename A, typename B, typename C, typename D, typename E, typename F>
+  static IndicatorParamsKey Make(const A _a, const B _b, const C _c, const D _d, const E _e, const F _f) {
+    IndicatorParamsKey _key = Make(_a, _b, _c, _d, _e);
+    _key.Add(_f);
+    return _key;
+  }
+
+  /**
+   * Creates key of the given values.
+   */
+  template <typename A, typename B, typename C, typename D, typename E, typename F, typename G>
+  static IndicatorParamsKey Make(const A _a, const B _b, const C _c, const D _d, const E _e, const F _f, const G _g) {
+    IndicatorParamsKey _key = Make(_a, _b, _c, _d, _e, _f);
+    _key.Add(_g);
+    return _key;
+  }
+
+  /* Getters */
+
+  /**
+   * Returns 64-bit hash of the values.
+   */
+  unsigned long GetHash() const { return hash; }
+
+  /**
+   * Returns number of integer values.
+   */
+  int GetValuesCount() const { return ArraySize(values); }
+
+  /**
+   * Returns integer value (or bit pattern of floating-point value) of the given index.
+   */
+  long GetValue(int _index) const { return values[_index]; }
+
+  /**
+   * Returns number of string values.
+   */
+  int GetStringsCount() const { return ArraySize(strings); }
+
+  /**
+   * Returns string value of the given index.
+   */
+  string GetString(int _index) const { return strings[_index]; }
+
+  /**
+   * Checks whether keys have the same values.
+   */
+  bool Equals(const IndicatorParamsKey &_key) const {
+    if (hash != _key.hash || ArraySize(values) != ArraySize(_key.values) ||
+        ArraySize(strings) != ArraySize(_key.strings)) {
+      return false;
+    }
+    for (int i = 0; i < ArraySize(values); ++i) {
+      if (values[i] != _key.values[i]) {
+        return false;
+      }
+    }
+    for (int i = 0; i < ArraySize(strings); ++i) {
+      if (strings[i] != _key.strings[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /* Modifiers */
+
+  /**
+   * Adds integer value (also bool and enum values).
+   */
+  void AddInteger(long _value) {
+    int _size = ArraySize(values);
+    ArrayResize(values, _size + 1, 8);
+    values[_size] = _value;
+    Mix((unsigned long)_value);
+  }
+
+  /**
+   * Adds floating-point value. Bit pattern is kept, so values are compared exactly.
+   */
+  void AddDouble(double _value) {
+    DictHashBits _bits;
+    // Both zeros compare equal, so they must produce the same key.
+    _bits.vdbl = _value == 0 ? 0 : _value;
+    AddInteger(_bits.vlong);
+  }
+
+  /**
+   * Adds string value.
+   */
+  void AddString(string _value) {
+    int _size = ArraySize(strings);
+    ArrayResize(strings, _size + 1, 4);
+    strings[_size] = _value;
+    // FNV-1a over string's characters.
+    unsigned long _h = 0xcbf29ce484222325;
+#ifdef __MQL__
+    int _len = StringLen(_value);
+    for (int i = 0; i < _len; ++i) {
+      _h = (_h ^ StringGetCharacter(_value, i)) * 0x100000001b3;
+    }
+#else
+    for (unsigned int i = 0; i < (unsigned int)_value.size(); ++i) {
+      _h = (_h ^ (unsigned char)_value[i]) * 0x100000001b3;
+    }
+#endif
+    Mix(_h);
+  }
+
+  /**
+   * Adds value of the given type (see AddInteger(), AddDouble() and AddString()).
+   */
+  void Add(int _value) { AddInteger(_value); }
+  void Add(unsigned int _value) { AddInteger(_value); }
+  void Add(long _value) { AddInteger(_value); }
+  void Add(double _value) { AddDouble(_value); }
+  void Add(string _value) { AddString(_value); }
+
+  /**
+   * Sets values and hash of the serialized key (see GetValue(), GetString() and GetHash()).
+   *
+   * Hash depends on the order values were added in, so it is restored as it was instead of being recalculated.
+   */
+  void Set(ARRAY_REF(long, _values), ARRAY_REF(string, _strings), unsigned long _hash) {
+    ArrayResize(values, ArraySize(_values));
+    for (int i = 0; i < ArraySize(_values); ++i) {
+      values[i] = _values[i];
+    }
+    ArrayResize(strings, ArraySize(_strings));
+    for (int i = 0; i < ArraySize(_strings); ++i) {
+      strings[i] = _strings[i];
+    }
+    hash = _hash;
+  }
+
+  /**
+   * Adds values of another key (e.g., of the data source indicator).
+   */
+  void AddKey(const IndicatorParamsKey &_key) {
+    AddInteger(ArraySize(_key.values));
+    for (int i = 0; i < ArraySize(_key.values); ++i) {
+      AddInteger(_key.values[i]);
+    }
+    AddInteger(ArraySize(_key.strings));
+    for (int i = 0; i < ArraySize(_key.strings); ++i) {
+      AddString(_key.strings[i]);
+    }
+  }
+};
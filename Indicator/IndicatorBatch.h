@@ -0,0 +1,241 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_BATCH_H
+#define INDICATOR_BATCH_H
+
+// Includes.
+#include "../Refs.mqh"
+#include "../Storage/ValueStorage.h"
+
+// Defines.
+#define INDICATOR_BATCH_REANCHOR 4096  // Number of bars after which sliding sums are recalculated from the window.
+
+/**
+ * Calculates the same indicator configuration over many independent series (lanes) at once, e.g. over all the traded
+ * symbols.
+ *
+ * Recursive indicators (EMA, RSI, ATR) can't be vectorized along a single series, but lanes are independent. So all
+ * the state is kept as structure of arrays, with values of all lanes next to each other, and each step advances all
+ * lanes by one bar in plain loops over lanes. Such loops have no dependencies between iterations, so they can be
+ * vectorized by the compiler (SSE/AVX lanes in C++ builds) and run as plain scalar loops otherwise.
+ *
+ * Layout of all the arrays is [row * lanes + lane], where row is an input, a mode, a state variable or a bar of the
+ * window.
+ */
+class IndicatorBatch : public Dynamic {
+ protected:
+  // Number of series.
+  int lanes;
+  // Number of inputs (e.g., high, low and close) and modes per lane.
+  int num_inputs;
+  int num_modes;
+  // Number of bars advanced so far. The last one may still be updated (see Update()).
+  int bars;
+  // State after the last bar and after the bar before it.
+  ARRAY(double, state);
+  ARRAY(double, committed);
+  // Windows of the past values. Each row keeps a bar, indexed by bar modulo depth.
+  ARRAY(double, rings);
+  ARRAY(int, ring_offsets);
+  ARRAY(int, ring_depths);
+  // Values of the last bar.
+  ARRAY(double, values);
+
+  /* Protected methods */
+
+  /**
+   * Adds state variables, initially zeroed.
+   *
+   * @return
+   *   Returns offset of the first variable's row.
+   */
+  int AddState(int _count = 1) {
+    int _offset = ArraySize(state);
+    ArrayResize(state, _offset + _count * lanes);
+    ArrayResize(committed, _offset + _count * lanes);
+    return _offset;
+  }
+
+  /**
+   * Adds window of the past values with room for the given number of bars.
+   *
+   * Row of the bar being calculated is overwritten on each recalculation, so the window has to hold all the bars read
+   * by the kernel along with the current one.
+   *
+   * @return
+   *   Returns index of the window.
+   */
+  int AddRing(int _depth) {
+    int _ring = ArraySize(ring_offsets);
+    ArrayResize(ring_offsets, _ring + 1);
+    ArrayResize(ring_depths, _ring + 1);
+    ring_offsets[_ring] = ArraySize(rings);
+    ring_depths[_ring] = _depth;
+    ArrayResize(rings, ring_offsets[_ring] + _depth * lanes);
+    return _ring;
+  }
+
+  /**
+   * Returns offset of the row of the window for the given bar.
+   */
+  int GetRingRow(int _ring, int _bar) { return ring_offsets[_ring] + (_bar % ring_depths[_ring]) * lanes; }
+
+  /**
+   * Calculates values of the last bar from the given inputs. State is already restored from the previous bar.
+   *
+   * @param _bar
+   *   Index of the bar (0 is the oldest).
+   */
+  virtual void Step(ARRAY_REF(double, _inputs), int _bar) = 0;
+
+ public:
+  /**
+   * Constructor.
+   */
+  IndicatorBatch(int _lanes, int _num_inputs, int _num_modes)
+      : lanes(_lanes), num_inputs(_num_inputs), num_modes(_num_modes), bars(0) {
+    ArrayResize(values, num_modes * lanes);
+    ArrayInitialize(values, 0.0);
+  }
+
+  /* Getters */
+
+  /**
+   * Returns number of series.
+   */
+  int GetLanes() { return lanes; }
+
+  /**
+   * Returns number of bars advanced so far.
+   */
+  int GetBars() { return bars; }
+
+  /**
+   * Returns value of the last bar of the given lane.
+   */
+  double GetValue(int _lane, int _mode = 0) { return values[_mode * lanes + _lane]; }
+
+  /**
+   * Copies values of the last bar of all lanes of the given mode.
+   */
+  void GetValues(ARRAY_REF(double, _out), int _mode = 0) {
+    ArrayResize(_out, lanes);
+    ArrayCopy(_out, values, 0, _mode * lanes, lanes);
+  }
+
+  /* Modifiers */
+
+  /**
+   * Clears state of all lanes.
+   */
+  virtual void Reset() {
+    bars = 0;
+    ArrayInitialize(state, 0.0);
+    ArrayInitialize(committed, 0.0);
+    ArrayInitialize(rings, 0.0);
+    ArrayInitialize(values, 0.0);
+  }
+
+  /**
+   * Advances all lanes by a new bar.
+   *
+   * @param _inputs
+   *   Inputs of the bar, as [input * lanes + lane].
+   */
+  void Advance(ARRAY_REF(double, _inputs)) {
+    ArrayCopy(committed, state);
+    Step(_inputs, bars++);
+  }
+
+  /**
+   * Recalculates the last bar (e.g., the forming one) from the updated inputs.
+   */
+  void Update(ARRAY_REF(double, _inputs)) {
+    if (bars == 0) {
+      Advance(_inputs);
+      return;
+    }
+    ArrayCopy(state, committed);
+    Step(_inputs, bars - 1);
+  }
+
+  /**
+   * OnCalculate()-like method over the set of series.
+   *
+   * Bars from prev_calculated - 1 are calculated, so the forming bar is recalculated. Any other access pattern
+   * restarts the calculation from the oldest bar.
+   *
+   * @param _series
+   *   Input series, as [input * lanes + lane]. All series must have at least rates_total values.
+   * @param _buffers
+   *   Output buffers, as [mode * lanes + lane].
+   *
+   * @return
+   *   Returns new prev_calculated.
+   */
+  int Calculate(int _rates_total, int _prev_calculated, ARRAY_REF(ValueStorage<double>*, _series),
+                ARRAY_REF(ValueStorage<double>*, _buffers)) {
+    int _start = _prev_calculated > 0 ? _prev_calculated - 1 : 0;
+    if (_start != bars && _start != bars - 1) {
+      Reset();
+      _start = 0;
+    }
+    int _count = _rates_total - _start;
+    if (_count <= 0) {
+      return _rates_total;
+    }
+
+    // Fetching all the needed inputs at once, series by series.
+    int _num_series = num_inputs * lanes;
+    ARRAY(double, _fetched);
+    ARRAY(double, _inputs);
+    ArrayResize(_fetched, _num_series * _count);
+    ArrayResize(_inputs, _num_series);
+    for (int k = 0; k < _num_series; ++k) {
+      _series[k] PTR_DEREF FetchRange(_start, _count, _fetched, k * _count);
+    }
+
+    for (int i = _start; i < _rates_total && !IsStopped(); ++i) {
+      for (int k = 0; k < _num_series; ++k) {
+        _inputs[k] = _fetched[k * _count + i - _start];
+      }
+      if (i < bars) {
+        Update(_inputs);
+      } else {
+        Advance(_inputs);
+      }
+      for (int k = 0; k < num_modes * lanes; ++k) {
+        _buffers[k] PTR_DEREF Store(i, values[k]);
+      }
+    }
+    return _rates_total;
+  }
+};
+
+#endif  // INDICATOR_BATCH_H
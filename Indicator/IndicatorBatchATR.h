@@ -0,0 +1,95 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_BATCH_ATR_H
+#define INDICATOR_BATCH_ATR_H
+
+// Includes.
+#include "IndicatorBatch.h"
+
+/**
+ * Average True Range over many series at once. Inputs are high, low and close prices. Values are the same as of
+ * the "Example ATR" indicator: SMA of the true range, with the first value at bar period (older bars are 0).
+ */
+class IndicatorBatchATR : public IndicatorBatch {
+ protected:
+  int period;
+  // State rows: previous close and sum of the true ranges of the window.
+  int s_close;
+  int s_sum;
+  // Window of the true ranges.
+  int ring;
+
+  /**
+   * Calculates values of the bar.
+   */
+  void Step(ARRAY_REF(double, _inputs), int _bar) override {
+    int l;
+    int _row = GetRingRow(ring, _bar);
+    int _old = _bar > period ? GetRingRow(ring, _bar - period) : 0;
+    for (l = 0; l < lanes; ++l) {
+      double _high = _inputs[l];
+      double _low = _inputs[lanes + l];
+      double _prev = state[s_close + l];
+      // True range of the first bar is unknown.
+      rings[_row + l] = _bar > 0 ? MathMax(_high, _prev) - MathMin(_low, _prev) : 0.0;
+      state[s_close + l] = _inputs[2 * lanes + l];
+    }
+
+    if (_bar > period && _bar % INDICATOR_BATCH_REANCHOR == 0) {
+      for (l = 0; l < lanes; ++l) {
+        state[s_sum + l] = 0;
+      }
+      for (int k = _bar - period + 1; k <= _bar; ++k) {
+        int _k_row = GetRingRow(ring, k);
+        for (l = 0; l < lanes; ++l) {
+          state[s_sum + l] += rings[_k_row + l];
+        }
+      }
+    } else {
+      for (l = 0; l < lanes; ++l) {
+        state[s_sum + l] += rings[_row + l] - (_bar > period ? rings[_old + l] : 0.0);
+      }
+    }
+    for (l = 0; l < lanes; ++l) {
+      values[l] = _bar >= period ? state[s_sum + l] / period : 0.0;
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  IndicatorBatchATR(int _lanes, int _period) : IndicatorBatch(_lanes, 3, 1), period(MathMax(_period, 1)) {
+    s_close = AddState();
+    s_sum = AddState();
+    ring = AddRing(period + 1);
+  }
+};
+
+#endif  // INDICATOR_BATCH_ATR_H
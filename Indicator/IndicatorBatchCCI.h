@@ -0,0 +1,102 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_BATCH_CCI_H
+#define INDICATOR_BATCH_CCI_H
+
+// Includes.
+#include "IndicatorBatch.h"
+
+/**
+ * Commodity Channel Index over many series at once. Input is the (typical) price. Values are the same as of
+ * Indi_CCI::Calculate(): the first value is at bar period - 1 (older bars are 0).
+ *
+ * Mean deviation needs a pass over the window, so each bar costs O(period), but the pass goes over all lanes.
+ */
+class IndicatorBatchCCI : public IndicatorBatch {
+ protected:
+  int period;
+  // Window of the prices.
+  int ring;
+  // SMA and mean deviation of the window of each lane.
+  ARRAY(double, sma);
+  ARRAY(double, dev);
+
+  /**
+   * Calculates values of the bar.
+   */
+  void Step(ARRAY_REF(double, _inputs), int _bar) override {
+    int l, k;
+    int _row = GetRingRow(ring, _bar);
+    for (l = 0; l < lanes; ++l) {
+      rings[_row + l] = _inputs[l];
+      values[l] = 0.0;
+    }
+    if (_bar < period - 1) {
+      return;
+    }
+
+    // Window is summed up for each bar, the same as in Indi_CCI::Calculate().
+    for (l = 0; l < lanes; ++l) {
+      sma[l] = 0.0;
+      dev[l] = 0.0;
+    }
+    for (k = _bar - period + 1; k <= _bar; ++k) {
+      int _k_row = GetRingRow(ring, k);
+      for (l = 0; l < lanes; ++l) {
+        sma[l] += rings[_k_row + l];
+      }
+    }
+    for (l = 0; l < lanes; ++l) {
+      sma[l] /= period;
+    }
+    for (k = _bar - period + 1; k <= _bar; ++k) {
+      int _k_row = GetRingRow(ring, k);
+      for (l = 0; l < lanes; ++l) {
+        dev[l] += MathAbs(rings[_k_row + l] - sma[l]);
+      }
+    }
+    double _multiplier = 0.015 / period;
+    for (l = 0; l < lanes; ++l) {
+      double _d = dev[l] * _multiplier;
+      values[l] = _d != 0.0 ? (_inputs[l] - sma[l]) / _d : 0.0;
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  IndicatorBatchCCI(int _lanes, int _period) : IndicatorBatch(_lanes, 1, 1), period(MathMax(_period, 1)) {
+    ring = AddRing(period);
+    ArrayResize(sma, lanes);
+    ArrayResize(dev, lanes);
+  }
+};
+
+#endif  // INDICATOR_BATCH_CCI_H
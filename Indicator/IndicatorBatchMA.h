@@ -0,0 +1,156 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_BATCH_MA_H
+#define INDICATOR_BATCH_MA_H
+
+// Includes.
+#include "IndicatorBatch.h"
+
+/**
+ * Moving averages (SMA, EMA, SMMA and LWMA) over many series at once. Values are the same as of Indi_MA's
+ * OnCalculate() methods: EMA starts at the first bar, the others at bar period - 1 (older bars are 0).
+ */
+class IndicatorBatchMA : public IndicatorBatch {
+ protected:
+  int period;
+  ENUM_MA_METHOD ma_method;
+  // State rows: moving average's value, plain and weighted sums of the window.
+  int s_value;
+  int s_sum;
+  int s_lsum;
+  // Window of the prices.
+  int ring;
+
+  /**
+   * Recalculates plain and weighted sums of the window ending at the given bar from the window of prices.
+   */
+  void Reanchor(int _bar) {
+    int l;
+    for (l = 0; l < lanes; ++l) {
+      state[s_sum + l] = 0;
+      state[s_lsum + l] = 0;
+    }
+    for (int k = 1; k <= period; ++k) {
+      int _row = GetRingRow(ring, _bar - period + k);
+      for (l = 0; l < lanes; ++l) {
+        state[s_sum + l] += k * rings[_row + l];
+        state[s_lsum + l] += rings[_row + l];
+      }
+    }
+  }
+
+  /**
+   * Calculates values of the bar.
+   */
+  void Step(ARRAY_REF(double, _inputs), int _bar) override {
+    int l;
+    int _row = GetRingRow(ring, _bar);
+    int _old = _bar >= period ? GetRingRow(ring, _bar - period) : 0;
+    for (l = 0; l < lanes; ++l) {
+      rings[_row + l] = _inputs[l];
+    }
+
+    switch (ma_method) {
+      case MODE_EMA: {
+        double _k = 2.0 / (1.0 + period);
+        for (l = 0; l < lanes; ++l) {
+          state[s_value + l] = _bar == 0 ? _inputs[l] : _inputs[l] * _k + state[s_value + l] * (1.0 - _k);
+          values[l] = state[s_value + l];
+        }
+        break;
+      }
+      case MODE_SMMA:
+        if (_bar < period) {
+          for (l = 0; l < lanes; ++l) {
+            state[s_sum + l] += _inputs[l];
+            state[s_value + l] = state[s_sum + l] / period;
+            values[l] = _bar == period - 1 ? state[s_value + l] : 0.0;
+          }
+        } else {
+          for (l = 0; l < lanes; ++l) {
+            state[s_value + l] = (state[s_value + l] * (period - 1) + _inputs[l]) / period;
+            values[l] = state[s_value + l];
+          }
+        }
+        break;
+      case MODE_LWMA: {
+        double _weight_sum = period * (period + 1) / 2.0;
+        if (_bar < period) {
+          for (l = 0; l < lanes; ++l) {
+            state[s_sum + l] += (_bar + 1) * _inputs[l];
+            state[s_lsum + l] += _inputs[l];
+          }
+        } else if (_bar % INDICATOR_BATCH_REANCHOR == 0) {
+          Reanchor(_bar);
+        } else {
+          // Sliding the weighted sum by the plain sum of the previous window.
+          for (l = 0; l < lanes; ++l) {
+            state[s_sum + l] += period * _inputs[l] - state[s_lsum + l];
+            state[s_lsum + l] += _inputs[l] - rings[_old + l];
+          }
+        }
+        for (l = 0; l < lanes; ++l) {
+          values[l] = _bar >= period - 1 ? state[s_sum + l] / _weight_sum : 0.0;
+        }
+        break;
+      }
+      default:
+        if (_bar < period) {
+          for (l = 0; l < lanes; ++l) {
+            state[s_lsum + l] += _inputs[l];
+          }
+        } else if (_bar % INDICATOR_BATCH_REANCHOR == 0) {
+          Reanchor(_bar);
+        } else {
+          for (l = 0; l < lanes; ++l) {
+            state[s_lsum + l] += _inputs[l] - rings[_old + l];
+          }
+        }
+        for (l = 0; l < lanes; ++l) {
+          values[l] = _bar >= period - 1 ? state[s_lsum + l] / period : 0.0;
+        }
+        break;
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  IndicatorBatchMA(int _lanes, int _period, ENUM_MA_METHOD _ma_method = MODE_SMA)
+      : IndicatorBatch(_lanes, 1, 1), period(MathMax(_period, 1)), ma_method(_ma_method) {
+    s_value = AddState();
+    s_sum = AddState();
+    s_lsum = AddState();
+    // Price leaving the window is read before the forming bar's row is overwritten on recalculation.
+    ring = AddRing(period + 1);
+  }
+};
+
+#endif  // INDICATOR_BATCH_MA_H
@@ -0,0 +1,87 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_BATCH_RSI_H
+#define INDICATOR_BATCH_RSI_H
+
+// Includes.
+#include "IndicatorBatch.h"
+
+/**
+ * RSI over many series at once. Values are the same as of Indi_RSI::Calculate(): the first value is at bar period
+ * (older bars are 0) and average gain and loss are smoothed by SMMA.
+ */
+class IndicatorBatchRSI : public IndicatorBatch {
+ protected:
+  int period;
+  // State rows: previous price, average (or sum, during warm-up) gain and loss.
+  int s_price;
+  int s_gain;
+  int s_loss;
+
+  /**
+   * Calculates values of the bar.
+   */
+  void Step(ARRAY_REF(double, _inputs), int _bar) override {
+    int l;
+    if (_bar == 0) {
+      for (l = 0; l < lanes; ++l) {
+        state[s_price + l] = _inputs[l];
+        values[l] = 0.0;
+      }
+      return;
+    }
+    // Sums of the first period gains and losses are averaged at bar period, newer bars are smoothed by SMMA.
+    double _keep = _bar > period ? period - 1.0 : 1.0;
+    double _div = _bar >= period ? period : 1.0;
+    for (l = 0; l < lanes; ++l) {
+      double _diff = _inputs[l] - state[s_price + l];
+      double _gain = (state[s_gain + l] * _keep + MathMax(_diff, 0.0)) / _div;
+      double _loss = (state[s_loss + l] * _keep + MathMax(-_diff, 0.0)) / _div;
+      state[s_price + l] = _inputs[l];
+      state[s_gain + l] = _gain;
+      state[s_loss + l] = _loss;
+      // The same as Indi_RSI::GetRSI().
+      values[l] = _bar < period ? 0.0
+                  : _loss == 0.0 ? (_gain == 0.0 ? 50.0 : 100.0)
+                                 : 100.0 - (100.0 / (1.0 + _gain / _loss));
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  IndicatorBatchRSI(int _lanes, int _period) : IndicatorBatch(_lanes, 1, 1), period(MathMax(_period, 1)) {
+    s_price = AddState();
+    s_gain = AddState();
+    s_loss = AddState();
+  }
+};
+
+#endif  // INDICATOR_BATCH_RSI_H
@@ -0,0 +1,156 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_BATCH_STOCHASTIC_H
+#define INDICATOR_BATCH_STOCHASTIC_H
+
+// Includes.
+#include "IndicatorBatch.h"
+
+/**
+ * Stochastic Oscillator over many series at once. Inputs are high, low and close prices (for STO_CLOSECLOSE, pass
+ * close prices as high and low). Values are the same as of the "Example Stochastic" indicator: main line (mode 0)
+ * starts at bar kperiod + slowing - 2 (older bars are 0) and signal line (mode 1), SMA of the main line, starts at
+ * bar dperiod - 1, so it averages zeros until the main line starts.
+ */
+class IndicatorBatchStochastic : public IndicatorBatch {
+ protected:
+  int kperiod;
+  int dperiod;
+  int slowing;
+  // Windows of the high and low prices, of the differences of close and range from the lowest low and of the main
+  // line.
+  int ring_high;
+  int ring_low;
+  int ring_close;
+  int ring_range;
+  int ring_main;
+  // Sums of the windows of each lane.
+  ARRAY(double, highest);
+  ARRAY(double, lowest);
+  ARRAY(double, sum_close);
+  ARRAY(double, sum_range);
+
+  /**
+   * Calculates values of the bar.
+   */
+  void Step(ARRAY_REF(double, _inputs), int _bar) override {
+    int l, k;
+    int _high_row = GetRingRow(ring_high, _bar);
+    int _low_row = GetRingRow(ring_low, _bar);
+    int _close_row = GetRingRow(ring_close, _bar);
+    int _range_row = GetRingRow(ring_range, _bar);
+    int _main_row = GetRingRow(ring_main, _bar);
+    for (l = 0; l < lanes; ++l) {
+      rings[_high_row + l] = _inputs[l];
+      rings[_low_row + l] = _inputs[lanes + l];
+      rings[_close_row + l] = 0.0;
+      rings[_range_row + l] = 0.0;
+      rings[_main_row + l] = 0.0;
+      values[l] = 0.0;
+      values[lanes + l] = 0.0;
+    }
+    if (_bar >= kperiod - 1) {
+      // Highest high and lowest low of the window.
+      for (l = 0; l < lanes; ++l) {
+        highest[l] = _inputs[l];
+        lowest[l] = _inputs[lanes + l];
+      }
+      for (k = _bar - kperiod + 1; k < _bar; ++k) {
+        int _k_high = GetRingRow(ring_high, k);
+        int _k_low = GetRingRow(ring_low, k);
+        for (l = 0; l < lanes; ++l) {
+          highest[l] = MathMax(highest[l], rings[_k_high + l]);
+          lowest[l] = MathMin(lowest[l], rings[_k_low + l]);
+        }
+      }
+      for (l = 0; l < lanes; ++l) {
+        rings[_close_row + l] = _inputs[2 * lanes + l] - lowest[l];
+        rings[_range_row + l] = highest[l] - lowest[l];
+      }
+    }
+
+    if (_bar >= kperiod + slowing - 2) {
+      // Main line, slowed down by summing the differences over the slowing period.
+      for (l = 0; l < lanes; ++l) {
+        sum_close[l] = 0.0;
+        sum_range[l] = 0.0;
+      }
+      for (k = _bar - slowing + 1; k <= _bar; ++k) {
+        int _k_close = GetRingRow(ring_close, k);
+        int _k_range = GetRingRow(ring_range, k);
+        for (l = 0; l < lanes; ++l) {
+          sum_close[l] += rings[_k_close + l];
+          sum_range[l] += rings[_k_range + l];
+        }
+      }
+      for (l = 0; l < lanes; ++l) {
+        rings[_main_row + l] = sum_range[l] == 0.0 ? 100.0 : sum_close[l] / sum_range[l] * 100.0;
+        values[l] = rings[_main_row + l];
+      }
+    }
+
+    if (_bar >= dperiod - 1) {
+      // Signal line.
+      for (l = 0; l < lanes; ++l) {
+        sum_close[l] = 0.0;
+      }
+      for (k = _bar - dperiod + 1; k <= _bar; ++k) {
+        int _k_main = GetRingRow(ring_main, k);
+        for (l = 0; l < lanes; ++l) {
+          sum_close[l] += rings[_k_main + l];
+        }
+      }
+      for (l = 0; l < lanes; ++l) {
+        values[lanes + l] = sum_close[l] / dperiod;
+      }
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  IndicatorBatchStochastic(int _lanes, int _kperiod, int _dperiod, int _slowing)
+      : IndicatorBatch(_lanes, 3, 2),
+        kperiod(MathMax(_kperiod, 1)),
+        dperiod(MathMax(_dperiod, 1)),
+        slowing(MathMax(_slowing, 1)) {
+    ring_high = AddRing(kperiod);
+    ring_low = AddRing(kperiod);
+    ring_close = AddRing(slowing);
+    ring_range = AddRing(slowing);
+    ring_main = AddRing(dperiod);
+    ArrayResize(highest, lanes);
+    ArrayResize(lowest, lanes);
+    ArrayResize(sum_close, lanes);
+    ArrayResize(sum_range, lanes);
+  }
+};
+
+#endif  // INDICATOR_BATCH_STOCHASTIC_H
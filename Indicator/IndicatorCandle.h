@@ -31,6 +31,7 @@
 
 // Includes.
 #include "../Buffer/BufferCandle.h"
+#include "../Buffer/BufferCandleCascade.h"
 #include "../Candle.struct.h"
 #include "../Indicator.mqh"
 
@@ -53,6 +54,9 @@ template <typename TS, typename TV>
 class IndicatorCandle : public Indicator<TS> {
  protected:
   BufferCandle<TV> icdata;
+  // Candles shared with indicators of other timeframes. When set, icdata is not used.
+  Ref<BufferCandleCascade<TV>> cascade;
+  int cascade_level;
 
  protected:
   /* Protected methods */
@@ -65,8 +69,7 @@ class IndicatorCandle : public Indicator<TS> {
   void Init() {
     // Along with indexing by shift, we can also index via timestamp!
     flags |= INDI_FLAG_INDEXABLE_BY_TIMESTAMP;
-    icdata.AddFlags(DICT_FLAG_FILL_HOLES_UNSORTED);
-    icdata.SetOverflowListener(IndicatorCandleOverflowListener, 10);
+    cascade_level = -1;
   }
 
  public:
@@ -100,59 +103,39 @@ class IndicatorCandle : public Indicator<TS> {
     ResetLastError();
     unsigned int _ishift = _index >= 0 ? _index : iparams.GetShift();
     long _candle_time = CalcCandleTimestamp(GetBarTime(_ishift));
-    long _curr_candle_time;
     CandleOCTOHLC<TV> _candle;
 
-    // Trying current and older shifts.
-    if (icdata.Size() > 0) {
-      int i = 0;
-      while (true) {
-        _curr_candle_time = CalcCandleTimestamp(GetBarTime(i++));
-
-        if (_curr_candle_time < icdata.GetMin()) {
-          // There is no older entries.
-          break;
-        }
-
-        _candle = icdata.GetByKey(_curr_candle_time);
-
-        if (_candle.IsValid()) {
-          break;
-        }
+    // Trying candle at the given shift, then the nearest older one (e.g., when there were no ticks for a while).
+    if (cascade.IsSet()) {
+      _candle = cascade.Ptr() PTR_DEREF GetCandle(cascade_level, _candle_time, _ishift);
+    } else {
+      int _pos = icdata.GetIndexByShift(_ishift, _candle_time);
+      if (_pos != -1) {
+        _candle = icdata.GetByIndex(_pos);
       }
     }
 
     if (!_candle.IsValid()) {
       // Giving up.
       DebugBreak();
-      Print(GetFullName(), ": Missing candle after thorough search at shift ", _index, " (", TimeToString(_candle_time),
-            "). Lowest timestamp in history is ", icdata.GetMin());
+      Print(GetFullName(), ": Missing candle at shift ", _index, " (", TimeToString(_candle_time),
+            "). Lowest timestamp in history is ",
+            cascade.IsSet() ? cascade.Ptr() PTR_DEREF GetOldestTimestamp(cascade_level) : icdata.GetMin());
     }
 
     return CandleToEntry(_candle_time, _candle);
   }
 
   /**
-   * Function should return true if resize can be made, or false to overwrite current slot.
+   * Candles are built from ticks and kept in their own buffer, so there are no entries to calculate.
    */
-  static bool IndicatorCandleOverflowListener(ENUM_DICT_OVERFLOW_REASON _reason, int _size, int _num_conflicts) {
-    switch (_reason) {
-      case DICT_OVERFLOW_REASON_FULL:
-        // We allow resize if dictionary size is less than 86400 slots.
-        return _size < 86400;
-      case DICT_OVERFLOW_REASON_TOO_MANY_CONFLICTS:
-      default:
-        // When there is too many conflicts, we just reject doing resize, so first conflicting slot will be reused.
-        break;
-    }
-    return false;
-  }
+  int BackfillEntries(int _shift, int _count) override { return 0; }
 
   /**
    * Sends historic entries to listening indicators. May be overriden.
    */
   void EmitHistory() override {
-    for (DictStructIterator<long, CandleOCTOHLC<TV>> iter(icdata.Begin()); iter.IsValid(); ++iter) {
+    for (BufferSeriesIterator<CandleOCTOHLC<TV>> iter(GetCandles() PTR_DEREF Begin()); iter.IsValid(); ++iter) {
       IndicatorDataEntry _entry = CandleToEntry(iter.Key(), iter.Value());
       EmitEntry(_entry);
     }
@@ -176,6 +159,12 @@ class IndicatorCandle : public Indicator<TS> {
    * Adds tick's price to the matching candle and updates its OHLC values.
    */
   void UpdateCandle(long _tick_timestamp, double _price) {
+    if (cascade.IsSet()) {
+      // Shared candles are updated once per tick, no matter how many indicators pass the tick.
+      cascade.Ptr() PTR_DEREF Tick(_tick_timestamp, (TV)_price);
+      return;
+    }
+
     long _candle_timestamp = CalcCandleTimestamp(_tick_timestamp);
 
 #ifdef __debug_verbose__
@@ -183,14 +172,31 @@ class IndicatorCandle : public Indicator<TS> {
           TimeToString(_tick_timestamp));
 #endif
 
-    CandleOCTOHLC<double> _candle(_price, _price, _price, _price, _tick_timestamp, _tick_timestamp);
-    if (icdata.KeyExists(_candle_timestamp)) {
-      // Candle already exists.
-      _candle = icdata.GetByKey(_candle_timestamp);
-      _candle.Update(_tick_timestamp, _price);
-    }
+    icdata.Update(_candle_timestamp, _tick_timestamp, (TV)_price);
+  }
 
-    icdata.Add(_candle, _candle_timestamp);
+  /**
+   * Makes indicator share candles with indicators of other timeframes fed by the same ticks.
+   *
+   * Ticks then build candles of the finest timeframe only, while coarser ones are rolled up from them. Set it before
+   * feeding any ticks.
+   */
+  void SetCandleCascade(BufferCandleCascade<TV>* _cascade) {
+    cascade = _cascade;
+    cascade_level = _cascade != NULL ? _cascade PTR_DEREF AddLevel(iparams.GetSecsPerCandle()) : -1;
+  }
+
+  /**
+   * Returns shared candles or NULL if indicator keeps its own ones.
+   */
+  BufferCandleCascade<TV>* GetCandleCascade() { return cascade.Ptr(); }
+
+  /**
+   * Returns buffer of candles. Candle which is still forming may miss the most recent ticks when candles are
+   * shared and rolled up from a shorter timeframe.
+   */
+  BufferCandle<TV>* GetCandles() {
+    return cascade.IsSet() ? cascade.Ptr() PTR_DEREF GetCandles(cascade_level) : &icdata;
   }
 
   /**
@@ -254,7 +260,7 @@ class IndicatorCandle : public Indicator<TS> {
 
   string CandlesToString() {
     string _result;
-    for (DictStructIterator<long, CandleOCTOHLC<TV>> iter(icdata.Begin()); iter.IsValid(); ++iter) {
+    for (BufferSeriesIterator<CandleOCTOHLC<TV>> iter(GetCandles() PTR_DEREF Begin()); iter.IsValid(); ++iter) {
       IndicatorDataEntry _entry = CandleToEntry(iter.Key(), iter.Value());
       _result += IntegerToString(iter.Key()) + ": " + _entry.ToString<double>() + "\n";
     }
@@ -0,0 +1,346 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_FILE_CACHE_H
+#define INDICATOR_FILE_CACHE_H
+
+// Includes.
+#include "../File.mqh"
+#include "../Indicator.struct.key.h"
+#include "../IndicatorData.mqh"
+
+// Defines.
+#define INDICATOR_FILE_CACHE_MAGIC 0x43494145  // "EAIC".
+#define INDICATOR_FILE_CACHE_VERSION 2
+
+/**
+ * Persists calculated entries of indicators between runs.
+ *
+ * Entries of an indicator are saved into a binary file named after the hash of its typed key (see
+ * IndicatorParamsKey), which covers the indicator's type, params, symbol, timeframe and the whole data source chain.
+ * On load, the file is checked against the key and the current history, so snapshot of different params or history
+ * is ignored. Then only bars newer than the last saved one have to be calculated (see Restore()).
+ *
+ * Calculate caches used by the indicator (see IndicatorCalculateCaches) are saved along with its entries, so
+ * OnCalculate kernels of on-indicator modes resume from their prev_calculated instead of a full pass. Caches holding
+ * calculation states (e.g., rolling windows) can't be restored from their buffers, so they are rebuilt.
+ *
+ * Only indicators whose params struct implements GetKey() can be persisted.
+ */
+class IndicatorFileCache {
+ protected:
+  /**
+   * Returns time of the oldest bar in the indicator's history. Buffers of calculate caches are indexed from it.
+   */
+  static long GetOldestBarTime(IndicatorData* _indi) {
+    return (long)_indi PTR_DEREF GetBarTime(_indi PTR_DEREF GetBars() - 1);
+  }
+
+  /**
+   * Saves calculate caches used by the indicator.
+   */
+  static void SaveCaches(IndicatorData* _indi, int _handle) {
+    long _user = _indi PTR_DEREF GetCalculateCacheUser();
+    ARRAY(int, _indices);
+    for (int i = 0; i < IndicatorCalculateCaches::Size(); ++i) {
+      IndicatorCalculateCache<double>* _cache = IndicatorCalculateCaches::GetByIndex(i);
+      if (_cache != NULL && _cache PTR_DEREF HasUser(_user) && !_cache PTR_DEREF HasStates() &&
+          _cache PTR_DEREF GetPrevCalculated() > 0) {
+        Util::ArrayPush(_indices, i);
+      }
+    }
+
+    FileWriteLong(_handle, GetOldestBarTime(_indi));
+    FileWriteInteger(_handle, ArraySize(_indices));
+    for (int i = 0; i < ArraySize(_indices); ++i) {
+      IndicatorParamsKey _key = IndicatorCalculateCaches::GetKeyByIndex(_indices[i]);
+      IndicatorCalculateCache<double>* _cache = IndicatorCalculateCaches::GetByIndex(_indices[i]);
+      FileWriteInteger(_handle, _key.GetValuesCount());
+      for (int j = 0; j < _key.GetValuesCount(); ++j) {
+        FileWriteLong(_handle, _key.GetValue(j));
+      }
+      FileWriteInteger(_handle, _key.GetStringsCount());
+      for (int j = 0; j < _key.GetStringsCount(); ++j) {
+        FileWriteInteger(_handle, StringLen(_key.GetString(j)));
+        FileWriteString(_handle, _key.GetString(j));
+      }
+      FileWriteLong(_handle, (long)_key.GetHash());
+      FileWriteInteger(_handle, _cache PTR_DEREF GetPrevCalculated());
+      FileWriteInteger(_handle, _cache PTR_DEREF NumBuffers());
+      for (int j = 0; j < _cache PTR_DEREF NumBuffers(); ++j) {
+        ValueStorage<double>* _buffer = _cache PTR_DEREF GetBuffer<double>(j);
+        FileWriteInteger(_handle, _buffer PTR_DEREF Size());
+        for (int k = 0; k < _buffer PTR_DEREF Size(); ++k) {
+          // Value is saved as raw bits, so kernels continue from exactly the same values.
+          DictHashBits _bits;
+          _bits.vdbl = _buffer PTR_DEREF Fetch(k);
+          FileWriteLong(_handle, _bits.vlong);
+        }
+      }
+      // Marks the complete record.
+      FileWriteInteger(_handle, INDICATOR_FILE_CACHE_MAGIC);
+    }
+  }
+
+  /**
+   * Loads saved calculate caches, unless they're already in use or the history doesn't start at the same bar.
+   *
+   * @return
+   *   Returns number of restored caches.
+   */
+  static int LoadCaches(IndicatorData* _indi, int _handle) {
+    bool _aligned = FileReadLong(_handle) == GetOldestBarTime(_indi);
+    int _count = FileReadInteger(_handle);
+    int _result = 0;
+    for (int i = 0; i < _count && !FileIsEnding(_handle); ++i) {
+      ARRAY(long, _values);
+      ARRAY(string, _strings);
+      ArrayResize(_values, FileReadInteger(_handle));
+      for (int j = 0; j < ArraySize(_values); ++j) {
+        _values[j] = FileReadLong(_handle);
+      }
+      ArrayResize(_strings, FileReadInteger(_handle));
+      for (int j = 0; j < ArraySize(_strings); ++j) {
+        _strings[j] = FileReadString(_handle, FileReadInteger(_handle));
+      }
+      IndicatorParamsKey _key;
+      _key.Set(_values, _strings, (unsigned long)FileReadLong(_handle));
+      int _prev_calculated = FileReadInteger(_handle);
+      int _num_buffers = FileReadInteger(_handle);
+
+      IndicatorCalculateCache<double>* _cache = IndicatorCalculateCaches::Find(_key);
+      if (!_aligned || _prev_calculated > _indi PTR_DEREF GetBars() ||
+          (_cache != NULL && _cache PTR_DEREF HasBuffers())) {
+        // Record is read through, but cache is left as it is.
+        _cache = NULL;
+      } else {
+        _cache = IndicatorCalculateCaches::GetByKey(_key);
+        _cache PTR_DEREF AddBuffer<NativeValueStorage<double>>(_num_buffers);
+      }
+      for (int j = 0; j < _num_buffers; ++j) {
+        int _size = FileReadInteger(_handle);
+        ValueStorage<double>* _buffer = _cache != NULL ? _cache PTR_DEREF GetBuffer<double>(j) : NULL;
+        if (_buffer != NULL) {
+          _buffer PTR_DEREF Resize(_size, 0);
+        }
+        for (int k = 0; k < _size; ++k) {
+          DictHashBits _bits;
+          _bits.vlong = FileReadLong(_handle);
+          if (_buffer != NULL) {
+            _buffer PTR_DEREF Store(k, _bits.vdbl);
+          }
+        }
+      }
+      if (FileReadInteger(_handle) != INDICATOR_FILE_CACHE_MAGIC) {
+        // Truncated file. Cache calculates its buffers from scratch.
+        break;
+      }
+      if (_cache != NULL) {
+        _cache PTR_DEREF SetPrevCalculated(_prev_calculated);
+        ++_result;
+      }
+    }
+    return _result;
+  }
+
+  /**
+   * Saves entries of the single indicator, except of the forming bar's one.
+   */
+  static bool SaveEntries(IndicatorData* _indi, string _path) {
+    IndicatorParamsKey _key;
+    if (!_indi PTR_DEREF GetKey(_key)) {
+      return false;
+    }
+    int _handle = FileOpen(_path, FILE_WRITE | FILE_BIN);
+    if (_handle == INVALID_HANDLE) {
+      return false;
+    }
+
+    BufferSeries<IndicatorDataEntry>* _data = _indi PTR_DEREF GetData();
+    // Entry of the forming bar may still change, so it isn't saved.
+    int _count = _data PTR_DEREF LowerBound((long)_indi PTR_DEREF GetBarTime(0));
+    string _name = _indi PTR_DEREF GetFullName();
+
+    FileWriteInteger(_handle, INDICATOR_FILE_CACHE_MAGIC);
+    FileWriteInteger(_handle, INDICATOR_FILE_CACHE_VERSION);
+    FileWriteLong(_handle, (long)_key.GetHash());
+    FileWriteInteger(_handle, StringLen(_name));
+    FileWriteString(_handle, _name);
+    FileWriteInteger(_handle, _count);
+    for (int i = 0; i < _count; ++i) {
+      IndicatorDataEntry _entry = _data PTR_DEREF GetByIndex(i);
+      FileWriteLong(_handle, _entry.timestamp);
+      FileWriteInteger(_handle, _entry.flags, SHORT_VALUE);
+      FileWriteInteger(_handle, _entry.GetSize(), SHORT_VALUE);
+      for (int j = 0; j < _entry.GetSize(); ++j) {
+        IndicatorDataEntryValue _value = _entry.GetEntryValue(j);
+        // Value is saved as raw bits along with its type.
+        FileWriteInteger(_handle, _value.flags, CHAR_VALUE);
+        FileWriteLong(_handle, _value.value.vlong);
+      }
+    }
+    SaveCaches(_indi, _handle);
+    FileClose(_handle);
+    return true;
+  }
+
+  /**
+   * Loads entries of the single indicator.
+   *
+   * @return
+   *   Returns number of loaded entries.
+   */
+  static int LoadEntries(IndicatorData* _indi, string _path) {
+    IndicatorParamsKey _key;
+    if (!_indi PTR_DEREF GetKey(_key) || !FileIsExist(_path)) {
+      return 0;
+    }
+    int _handle = FileOpen(_path, FILE_READ | FILE_BIN);
+    if (_handle == INVALID_HANDLE) {
+      return 0;
+    }
+
+    ARRAY(IndicatorDataEntry, _entries);
+    string _name = _indi PTR_DEREF GetFullName();
+    if (FileReadInteger(_handle) == INDICATOR_FILE_CACHE_MAGIC &&
+        FileReadInteger(_handle) == INDICATOR_FILE_CACHE_VERSION && FileReadLong(_handle) == (long)_key.GetHash() &&
+        FileReadString(_handle, FileReadInteger(_handle)) == _name) {
+      int _count = FileReadInteger(_handle);
+      ArrayResize(_entries, _count);
+      for (int i = 0; i < _count; ++i) {
+        if (FileIsEnding(_handle)) {
+          // Truncated file.
+          ArrayResize(_entries, 0);
+          break;
+        }
+        _entries[i].timestamp = FileReadLong(_handle);
+        _entries[i].flags = (unsigned short)FileReadInteger(_handle, SHORT_VALUE);
+        int _size = FileReadInteger(_handle, SHORT_VALUE);
+        _entries[i].Resize(_size);
+        for (int j = 0; j < _size; ++j) {
+          IndicatorDataEntryValue _value;
+          _value.flags = (unsigned char)FileReadInteger(_handle, CHAR_VALUE);
+          _value.value.vlong = FileReadLong(_handle);
+          _entries[i].SetEntryValue(j, _value);
+        }
+      }
+      if (ArraySize(_entries) > 0) {
+        LoadCaches(_indi, _handle);
+      }
+    }
+    FileClose(_handle);
+
+    int _count = ArraySize(_entries);
+    if (_count == 0 || _indi PTR_DEREF GetBarShift((datetime)_entries[_count - 1].timestamp, true) < 0) {
+      // Newest saved bar is missing in the current history, so history has changed since the snapshot.
+      return 0;
+    }
+
+    BufferSeries<IndicatorDataEntry>* _data = _indi PTR_DEREF GetData();
+    _data PTR_DEREF Reserve(_data PTR_DEREF Size() + _count);
+    for (int i = 0; i < _count; ++i) {
+      _data PTR_DEREF Add(_entries[i], _entries[i].timestamp);
+    }
+    return _count;
+  }
+
+ public:
+  /**
+   * Returns path of the indicator's cache file or empty string if indicator can't be identified by its params.
+   *
+   * @param _dir
+   *   Directory (within the file sandbox) with the cache files.
+   */
+  static string GetPath(IndicatorData* _indi, string _dir = "") {
+    IndicatorParamsKey _key;
+    if (!_indi PTR_DEREF GetKey(_key)) {
+      return "";
+    }
+    return (_dir != "" ? _dir + "\\" : "") + "IndicatorCache_" + IntegerToString((long)_key.GetHash()) + ".bin";
+  }
+
+  /**
+   * Saves calculated entries of the indicator and all the indicators it depends on.
+   *
+   * @return
+   *   Returns false if any of the cache files couldn't be written.
+   */
+  static bool Save(IndicatorData* _indi, string _dir = "") {
+    ARRAY(IndicatorData*, _order);
+    _indi PTR_DEREF GetDependencyOrder(_order);
+    bool _result = true;
+    for (int i = 0; i < ArraySize(_order); ++i) {
+      string _path = GetPath(_order[i], _dir);
+      if (_path != "") {
+        _result &= SaveEntries(_order[i], _path);
+      }
+    }
+    return _result;
+  }
+
+  /**
+   * Loads saved entries of the indicator and all the indicators it depends on.
+   *
+   * @return
+   *   Returns number of entries loaded for the given indicator.
+   */
+  static int Load(IndicatorData* _indi, string _dir = "") {
+    ARRAY(IndicatorData*, _order);
+    _indi PTR_DEREF GetDependencyOrder(_order);
+    int _result = 0;
+    for (int i = 0; i < ArraySize(_order); ++i) {
+      string _path = GetPath(_order[i], _dir);
+      // The last one is the given indicator.
+      _result = _path != "" ? LoadEntries(_order[i], _path) : 0;
+    }
+    return _result;
+  }
+
+  /**
+   * Loads saved entries and backfills the given number of bars, calculating only bars newer than the saved ones.
+   *
+   * Whole range is backfilled when snapshot doesn't cover its oldest bar.
+   *
+   * @return
+   *   Returns number of entries calculated for the given indicator.
+   */
+  static int Restore(IndicatorData* _indi, int _count, string _dir = "") {
+    if (_count <= 0) {
+      return 0;
+    }
+    Load(_indi, _dir);
+    BufferSeries<IndicatorDataEntry>* _data = _indi PTR_DEREF GetData();
+    if (_data PTR_DEREF Size() == 0 || _data PTR_DEREF GetMin() > (long)_indi PTR_DEREF GetBarTime(_count - 1)) {
+      return _indi PTR_DEREF Backfill(_count);
+    }
+    int _newer = _indi PTR_DEREF GetBarShift((datetime)_data PTR_DEREF GetMax());
+    return _newer > 0 ? _indi PTR_DEREF Backfill(MathMin(_newer, _count)) : 0;
+  }
+};
+
+#endif  // INDICATOR_FILE_CACHE_H
@@ -0,0 +1,121 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_KEY_DICT_H
+#define INDICATOR_KEY_DICT_H
+
+// Includes.
+#include "../Dict.mqh"
+#include "../Indicator.struct.key.h"
+#include "../Refs.mqh"
+
+/**
+ * Maps typed keys (see IndicatorParamsKey) to reference-counted objects.
+ *
+ * Entries are never removed, so their indices stay valid. Value of an entry may be unset and set again later.
+ */
+template <typename V>
+class IndicatorKeyDict {
+ protected:
+  // Registered keys and values, in the order of registration.
+  ARRAY(IndicatorParamsKey, keys);
+  ARRAY(Ref<V>, values);
+  // Index of the registered key by its slot. Slot is the key's hash or the following free one on hash collision.
+  Dict<long, int> slots;
+
+  /**
+   * Returns slot of the equal registered key or the first free slot if there's none.
+   *
+   * @param _index
+   *   Receives index of the equal registered key or -1.
+   */
+  long FindSlot(IndicatorParamsKey& _key, int& _index) {
+    long _slot = (long)_key.GetHash();
+    while (slots.KeyExists(_slot)) {
+      _index = slots.GetByKey(_slot);
+      if (keys[_index].Equals(_key)) {
+        return _slot;
+      }
+      ++_slot;
+    }
+    _index = -1;
+    return _slot;
+  }
+
+ public:
+  /**
+   * Returns index of the equal registered key or -1 if there's none.
+   */
+  int Find(IndicatorParamsKey& _key) {
+    int _index;
+    FindSlot(_key, _index);
+    return _index;
+  }
+
+  /**
+   * Registers key if not yet registered.
+   *
+   * @return
+   *   Returns index of the key.
+   */
+  int Add(IndicatorParamsKey& _key) {
+    int _index;
+    long _slot = FindSlot(_key, _index);
+    if (_index == -1) {
+      Ref<V> _ref;
+      _index = ArraySize(keys);
+      ArrayResize(keys, _index + 1, 16);
+      keys[_index] = _key;
+      ArrayPushObject(values, _ref);
+      slots.Set(_slot, _index);
+    }
+    return _index;
+  }
+
+  /**
+   * Returns key of the entry.
+   */
+  IndicatorParamsKey GetKeyByIndex(int _index) { return keys[_index]; }
+
+  /**
+   * Returns value of the entry or NULL if it is unset.
+   */
+  V* GetByIndex(int _index) { return values[_index].Ptr(); }
+
+  /**
+   * Sets value of the entry. Previous value is deleted unless something else keeps a reference to it.
+   */
+  void SetByIndex(int _index, V* _value) { values[_index] = _value; }
+
+  /**
+   * Returns number of registered keys.
+   */
+  int Size() { return ArraySize(keys); }
+};
+
+#endif  // INDICATOR_KEY_DICT_H
@@ -0,0 +1,192 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_PRIMITIVES_H
+#define INDICATOR_PRIMITIVES_H
+
+// Includes.
+#include "../Indicator.struct.cache.h"
+#include "../IndicatorData.mqh"
+#include "IndicatorKeyDict.h"
+
+// Rolling primitives calculated over the source indicator's buffer.
+enum ENUM_INDI_PRIMITIVE {
+  INDI_PRIMITIVE_SMA,      // Simple moving average.
+  INDI_PRIMITIVE_EMA,      // Exponential moving average.
+  INDI_PRIMITIVE_SMMA,     // Smoothed moving average.
+  INDI_PRIMITIVE_LWMA,     // Linear-weighted moving average.
+  INDI_PRIMITIVE_MOMENTS,  // Rolling mean and standard deviation (sum and sum of squares).
+};
+
+/**
+ * Shares calculation caches of rolling primitives between indicators.
+ *
+ * Indicators calculated on other indicators (e.g., MA, Envelopes, Bands or StdDev on the same source) often calculate
+ * the same moving average or moments of the same source buffer. Instead of keeping a private cache each, they request
+ * the cache of the primitive keyed by the source indicator, its mode, the kind of primitive and the period, so the
+ * primitive is calculated once per bar and its buffers serve every consumer.
+ *
+ * Layout of the cache is up to the primitive's calculation method: moving averages keep their values in the first
+ * buffer (see Indi_MA::iMAOnArray()), moments keep standard deviation and mean in the first two buffers and
+ * RollingMoments in the first state (see Indi_StdDev::Calculate()).
+ *
+ * Caches themselves are held by IndicatorCalculateCaches, so they are tracked and persisted as any other calculate
+ * cache.
+ */
+class IndicatorPrimitives {
+ protected:
+  // Keys of the registered primitives. Values are unused.
+  IndicatorKeyDict<Dynamic> caches;
+  // Description and consumers of each primitive, used by the report.
+  ARRAY(string, names);
+  ARRAY(string, consumers);
+  ARRAY(int, num_consumers);
+
+  /**
+   * Returns the instance.
+   */
+  static IndicatorPrimitives* GetInstance() {
+    static IndicatorPrimitives _instance;
+    return &_instance;
+  }
+
+  /**
+   * Adds consumer to the primitive, if not yet added.
+   */
+  void AddConsumer(int _index, string _consumer) {
+    string _list = "," + consumers[_index] + ",";
+    if (StringFind(_list, "," + _consumer + ",") != -1) {
+      return;
+    }
+    consumers[_index] += (num_consumers[_index] > 0 ? "," : "") + _consumer;
+    ++num_consumers[_index];
+  }
+
+ public:
+  /**
+   * Returns name of the primitive.
+   */
+  static string GetPrimitiveName(ENUM_INDI_PRIMITIVE _type) {
+    switch (_type) {
+      case INDI_PRIMITIVE_SMA:
+        return "SMA";
+      case INDI_PRIMITIVE_EMA:
+        return "EMA";
+      case INDI_PRIMITIVE_SMMA:
+        return "SMMA";
+      case INDI_PRIMITIVE_LWMA:
+        return "LWMA";
+      case INDI_PRIMITIVE_MOMENTS:
+        return "Moments";
+    }
+    return "Unknown";
+  }
+
+  /**
+   * Returns moving average primitive for the given MA method.
+   */
+  static ENUM_INDI_PRIMITIVE GetMAPrimitive(ENUM_MA_METHOD _ma_method) {
+    switch (_ma_method) {
+      case MODE_EMA:
+        return INDI_PRIMITIVE_EMA;
+      case MODE_SMMA:
+        return INDI_PRIMITIVE_SMMA;
+      case MODE_LWMA:
+        return INDI_PRIMITIVE_LWMA;
+    }
+    return INDI_PRIMITIVE_SMA;
+  }
+
+  /**
+   * Returns cache of the primitive calculated on the given mode of the source indicator.
+   *
+   * @param _consumer
+   *   Name of the requesting indicator, used by the report.
+   */
+  static IndicatorCalculateCache<double>* GetCache(IndicatorData* _source, int _mode, ENUM_INDI_PRIMITIVE _type,
+                                                    int _period, string _consumer) {
+    IndicatorPrimitives* _primitives = GetInstance();
+    IndicatorParamsKey _key;
+    // Keeps keys of primitives apart from keys of the other calculate caches.
+    _key.AddString("IndicatorPrimitives");
+    if (!_source PTR_DEREF GetKey(_key)) {
+      // Source can't describe its params, so it is identified by its name, as in INDICATOR_CALCULATE_POPULATE_CACHE.
+      _key.AddString(_source PTR_DEREF GetFullName());
+    }
+    _key.AddInteger(_mode);
+    _key.AddInteger(_type);
+    _key.AddInteger(_period);
+
+    int _index = _primitives PTR_DEREF caches.Find(_key);
+    if (_index == -1) {
+      _index = _primitives PTR_DEREF caches.Add(_key);
+      ArrayResize(_primitives PTR_DEREF names, _index + 1, 16);
+      ArrayResize(_primitives PTR_DEREF consumers, _index + 1, 16);
+      ArrayResize(_primitives PTR_DEREF num_consumers, _index + 1, 16);
+      _primitives PTR_DEREF names[_index] = GetPrimitiveName(_type) + "(" + IntegerToString(_period) + ") of " +
+                                            _source PTR_DEREF GetFullName() + "[" + IntegerToString(_mode) + "]";
+      _primitives PTR_DEREF consumers[_index] = "";
+      _primitives PTR_DEREF num_consumers[_index] = 0;
+    }
+    _primitives PTR_DEREF AddConsumer(_index, _consumer);
+    return IndicatorCalculateCaches::GetByKey(_key);
+  }
+
+  /**
+   * Returns number of calculated primitives.
+   */
+  static int Size() { return GetInstance() PTR_DEREF caches.Size(); }
+
+  /**
+   * Returns number of primitives used by more than one indicator.
+   */
+  static int GetSharedCount() {
+    IndicatorPrimitives* _primitives = GetInstance();
+    int _result = 0;
+    for (int i = 0; i < ArraySize(_primitives PTR_DEREF num_consumers); ++i) {
+      _result += _primitives PTR_DEREF num_consumers[i] > 1 ? 1 : 0;
+    }
+    return _result;
+  }
+
+  /**
+   * Returns report of the calculated primitives and indicators using them.
+   */
+  static string ToString() {
+    IndicatorPrimitives* _primitives = GetInstance();
+    string _result = "Rolling primitives: " + IntegerToString(Size()) + ", shared: " +
+                     IntegerToString(GetSharedCount()) + "\n";
+    for (int i = 0; i < ArraySize(_primitives PTR_DEREF names); ++i) {
+      _result += _primitives PTR_DEREF names[i] + ": " + IntegerToString(_primitives PTR_DEREF num_consumers[i]) +
+                 " consumer(s) (" + _primitives PTR_DEREF consumers[i] + ")\n";
+    }
+    return _result;
+  }
+};
+
+#endif  // INDICATOR_PRIMITIVES_H
@@ -0,0 +1,215 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef INDICATOR_REGISTRY_H
+#define INDICATOR_REGISTRY_H
+
+// Includes.
+#include "../Indicator.struct.key.h"
+#include "../Indicator.mqh"
+#include "IndicatorKeyDict.h"
+
+/**
+ * Shares structurally equal indicators.
+ *
+ * Indicators of the same type, params, symbol and data source are registered under their typed key (see
+ * IndicatorParamsKey), so all the strategies asking for the same indicator get one shared, reference-counted instance
+ * with a single data cache instead of each one calculating its own copy.
+ *
+ * Sharing is opt-in: GetOrCreate() creates the indicator only when there's no equal one yet, so instances created by
+ * the caller are never swapped or deleted. Shared indicators are frozen, so their params and data source can't be
+ * changed by one of their users. Registry counts users of each shared indicator and keeps a reference to it until the
+ * last user releases it (see Release()).
+ *
+ * Indicators returned by the GetCached() helpers are kept apart (see Get() and Set()). They aren't frozen and are
+ * never released, so they live until the end of the program.
+ *
+ * Only indicators whose params struct implements GetKey() can be shared.
+ */
+class IndicatorRegistry {
+ protected:
+  // Indicators of the GetCached() helpers by their keys.
+  IndicatorKeyDict<IndicatorData> cached;
+  // Shared indicators by their keys.
+  IndicatorKeyDict<IndicatorData> shared;
+  // Number of users of each shared indicator, indexed as the keys.
+  ARRAY(int, users);
+
+  /**
+   * Returns the registry.
+   */
+  static IndicatorRegistry* GetInstance() {
+    static IndicatorRegistry _instance;
+    return &_instance;
+  }
+
+  /**
+   * Returns index of the shared indicator or -1 if it isn't shared.
+   */
+  int IndexOf(IndicatorBase* _indi) {
+    for (int i = 0; i < shared.Size(); ++i) {
+      IndicatorBase* _shared = shared.GetByIndex(i);
+      if (_shared != NULL && _shared == _indi) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * Drops the shared indicator, so an equal indicator requested afterwards is created anew.
+   *
+   * Indicator gets deleted unless some of its users still keep a reference to it.
+   */
+  void Drop(int _index) {
+    users[_index] = 0;
+    shared.SetByIndex(_index, NULL);
+  }
+
+ public:
+  /**
+   * Returns indicator cached with the given key or NULL if there's none.
+   */
+  static IndicatorData* Get(IndicatorParamsKey& _key) {
+    IndicatorRegistry* _registry = GetInstance();
+    int _index = _registry PTR_DEREF cached.Find(_key);
+    return _index != -1 ? _registry PTR_DEREF cached.GetByIndex(_index) : NULL;
+  }
+
+  /**
+   * Caches indicator with the given key, if there's none yet.
+   *
+   * @return
+   *   Returns indicator already cached with the equal key or the given one.
+   */
+  static IndicatorData* Set(IndicatorParamsKey& _key, IndicatorData* _indi) {
+    IndicatorRegistry* _registry = GetInstance();
+    int _index = _registry PTR_DEREF cached.Add(_key);
+    IndicatorData* _cached = _registry PTR_DEREF cached.GetByIndex(_index);
+    if (_cached == NULL) {
+      _registry PTR_DEREF cached.SetByIndex(_index, _indi);
+      _cached = _indi;
+    }
+    return _cached;
+  }
+
+  /**
+   * Returns shared indicator of the given params and data source and adds a user to it.
+   *
+   * Indicator is created (and frozen) only when there's no equal one yet. Shared indicator whose key has changed
+   * anyway, e.g., by a setter of its own params, is no longer shared and an equal one is created instead. Indicators
+   * which can't be shared are created for each call and aren't registered.
+   *
+   * Callers keep their own reference to the returned indicator and call Release() once it is no longer needed.
+   *
+   * @param _indi_src
+   *   Data source of the indicator. Indicator is built-in when there's none.
+   * @param _symbol
+   *   Symbol of the indicator. NULL means the current one.
+   */
+  template <typename C, typename TS>
+  static C* GetOrCreate(TS& _params, IndicatorData* _indi_src = NULL, int _indi_src_mode = 0, string _symbol = NULL) {
+    IndicatorRegistry* _registry = GetInstance();
+    if (_symbol == NULL) {
+      _symbol = _Symbol;
+    }
+    ENUM_IDATA_SOURCE_TYPE _idstype = _indi_src != NULL ? IDATA_INDICATOR : IDATA_BUILTIN;
+    IndicatorParamsKey _key;
+    bool _can_share = Indicator<TS>::MakeKey(_key, _params, _symbol, _idstype, _indi_src_mode, _indi_src);
+    int _index = _can_share ? _registry PTR_DEREF shared.Add(_key) : -1;
+    if (_index != -1) {
+      if (_index >= ArraySize(_registry PTR_DEREF users)) {
+        ArrayResize(_registry PTR_DEREF users, _index + 1, 16);
+        _registry PTR_DEREF users[_index] = 0;
+      }
+      IndicatorData* _shared = _registry PTR_DEREF shared.GetByIndex(_index);
+      IndicatorParamsKey _current;
+      if (_shared != NULL && (!_shared PTR_DEREF GetKey(_current) || !_current.Equals(_key))) {
+        // Indicator has been changed since it was shared.
+        _registry PTR_DEREF Drop(_index);
+        _shared = NULL;
+      }
+      if (_shared != NULL) {
+        ++_registry PTR_DEREF users[_index];
+        return (C*)_shared;
+      }
+    }
+    C* _indi = new C(_params, _idstype, _indi_src, _indi_src_mode);
+    _indi PTR_DEREF SetSymbol(_symbol);
+    if (_index != -1) {
+      _indi PTR_DEREF Freeze();
+      _registry PTR_DEREF shared.SetByIndex(_index, _indi);
+      _registry PTR_DEREF users[_index] = 1;
+    }
+    return _indi;
+  }
+
+  /**
+   * Removes user of the shared indicator.
+   *
+   * Once the last user is removed, registry drops its reference, so the indicator gets deleted unless something else
+   * keeps a reference to it. Equal indicator requested afterwards is created anew.
+   *
+   * @return
+   *   Returns false if indicator isn't shared (e.g., it couldn't be shared).
+   */
+  static bool Release(IndicatorBase* _indi) {
+    IndicatorRegistry* _registry = GetInstance();
+    int _index = _registry PTR_DEREF IndexOf(_indi);
+    if (_index == -1) {
+      return false;
+    }
+    if (--_registry PTR_DEREF users[_index] <= 0) {
+      _registry PTR_DEREF Drop(_index);
+    }
+    return true;
+  }
+
+  /**
+   * Returns number of users of the shared indicator or 0 if it isn't shared.
+   */
+  static int GetUsers(IndicatorBase* _indi) {
+    IndicatorRegistry* _registry = GetInstance();
+    int _index = _registry PTR_DEREF IndexOf(_indi);
+    return _index != -1 ? _registry PTR_DEREF users[_index] : 0;
+  }
+
+  /**
+   * Returns number of shared indicators.
+   */
+  static int Size() {
+    IndicatorRegistry* _registry = GetInstance();
+    int _result = 0;
+    for (int i = 0; i < _registry PTR_DEREF shared.Size(); ++i) {
+      _result += _registry PTR_DEREF shared.GetByIndex(i) != NULL ? 1 : 0;
+    }
+    return _result;
+  }
+};
+
+#endif  // INDICATOR_REGISTRY_H
@@ -243,6 +243,14 @@ class IndicatorBase : public Chart {
    */
   virtual string GetDescriptiveName() { return GetName(); }
 
+  /**
+   * Builds key identifying structurally equal indicators (see IndicatorRegistry).
+   *
+   * @return
+   *   Returns false if indicator can't be shared.
+   */
+  virtual bool GetKey(IndicatorParamsKey& _key) { return false; }
+
   /* Setters */
 
   /**
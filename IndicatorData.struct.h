@@ -27,6 +27,8 @@
 
 // Defines.
 #define STRUCT_ENUM_IDATA_PARAM STRUCT_ENUM(IndicatorDataParams, ENUM_IDATA_PARAM)
+// Number of IndicatorDataEntry values stored inline (without heap allocation).
+#define INDI_DATA_ENTRY_INLINE_VALUES 8
 
 // Includes.
 #include "Indicator.struct.cache.h"
@@ -177,12 +179,22 @@ struct IndicatorDataEntryValue {
 struct IndicatorDataEntry {
   long timestamp;        // Timestamp of the entry's bar.
   unsigned short flags;  // Indicator entry flags.
-  ARRAY(IndicatorDataEntryValue, values);
+  int size;              // Number of values.
+  // First values, stored inline, so entries with up to INDI_DATA_ENTRY_INLINE_VALUES modes are copied without heap
+  // allocation. Values beyond that are stored in values_ext.
+  IndicatorDataEntryValue values[INDI_DATA_ENTRY_INLINE_VALUES];
+  ARRAY(IndicatorDataEntryValue, values_ext);
 
   // Constructors.
-  IndicatorDataEntry(int _size = 1) : flags(INDI_ENTRY_FLAG_NONE), timestamp(0) { Resize(_size); }
+  IndicatorDataEntry(int _size = 1) : flags(INDI_ENTRY_FLAG_NONE), timestamp(0), size(0) { Resize(_size); }
   IndicatorDataEntry(IndicatorDataEntry &_entry) { THIS_REF = _entry; }
-  int GetSize() { return ArraySize(values); }
+#ifndef __MQL__
+  IndicatorDataEntry(const IndicatorDataEntry &_entry) = default;
+  IndicatorDataEntry(IndicatorDataEntry &&_entry) = default;
+  IndicatorDataEntry &operator=(const IndicatorDataEntry &_entry) = default;
+  IndicatorDataEntry &operator=(IndicatorDataEntry &&_entry) = default;
+#endif
+  int GetSize() { return size; }
   // Operator overloading methods.
   template <typename T>
   T operator*(const T _value) {
@@ -202,25 +214,22 @@ struct IndicatorDataEntry {
   }
   template <typename T, typename I>
   T operator[](I _index) {
-    return values[(int)_index].Get<T>();
+    return GetValue<T>((int)_index);
   }
   template <>
   double operator[](int _index) {
-    if (_index >= ArraySize(values)) {
+    if (_index >= size) {
       return 0;
     }
-    double _value;
-    values[_index].Get(_value);
-    return _value;
+    return GetValue<double>(_index);
   }
   // Checkers.
   template <typename T>
   bool HasValue(T _value) {
     bool _result = false;
-    int _asize = ArraySize(values);
     T _value2;
-    for (int i = 0; i < _asize; i++) {
-      values[i].Get(_value2);
+    for (int i = 0; i < size; i++) {
+      _value2 = GetValue<T>(i);
       if (_value == _value2) {
         _result = true;
         break;
@@ -253,46 +262,53 @@ struct IndicatorDataEntry {
   void GetArray(ARRAY_REF(T, _out), int _size = 0) {
     int _asize = _size > 0 ? _size : ArraySize(_out);
     for (int i = 0; i < _asize; i++) {
-      values[i].Get(_out[i]);
+      _out[i] = GetValue<T>(i);
     }
   };
   template <typename T>
   T GetAvg(int _size = 0) {
-    int _asize = _size > 0 ? _size : ArraySize(values);
+    int _asize = _size > 0 ? _size : size;
     T _avg = GetSum<T>() / _asize;
     return _avg;
   };
   template <typename T>
   T GetMin(int _size = 0) {
-    int _asize = _size > 0 ? _size : ArraySize(values);
+    int _asize = _size > 0 ? _size : size;
     int _index = 0;
     for (int i = 1; i < _asize; i++) {
-      _index = values[i].Get<T>() < values[_index].Get<T>() ? i : _index;
+      _index = GetValue<T>(i) < GetValue<T>(_index) ? i : _index;
     }
-    return values[_index].Get<T>();
+    return GetValue<T>(_index);
   };
   template <typename T>
   T GetMax(int _size = 0) {
-    int _asize = _size > 0 ? _size : ArraySize(values);
+    int _asize = _size > 0 ? _size : size;
     int _index = 0;
     for (int i = 1; i < _asize; i++) {
-      _index = values[i].Get<T>() > values[_index].Get<T>() ? i : _index;
+      _index = GetValue<T>(i) > GetValue<T>(_index) ? i : _index;
     }
-    return values[_index].Get<T>();
+    return GetValue<T>(_index);
   };
   template <typename T>
   T GetSum(int _size = 0) {
-    int _asize = _size > 0 ? _size : ArraySize(values);
+    int _asize = _size > 0 ? _size : size;
     T _sum = 0;
     for (int i = 1; i < _asize; i++) {
-      _sum = +values[i].Get<T>();
+      _sum = +GetValue<T>(i);
     }
     return _sum;
   };
   template <typename T>
   T GetValue(int _index = 0) {
-    return values[_index].Get<T>();
+    return _index < INDI_DATA_ENTRY_INLINE_VALUES ? values[_index].Get<T>()
+                                                  : values_ext[_index - INDI_DATA_ENTRY_INLINE_VALUES].Get<T>();
   };
+  IndicatorDataEntryValue GetEntryValue(int _index) {
+    if (_index < INDI_DATA_ENTRY_INLINE_VALUES) {
+      return values[_index];
+    }
+    return values_ext[_index - INDI_DATA_ENTRY_INLINE_VALUES];
+  }
   template <typename T>
   void GetValues(T &_out1, T &_out2) {
     values[0].Get(_out1);
@@ -317,7 +333,7 @@ struct IndicatorDataEntry {
   int GetMonth() { return DateTimeStatic::Month(timestamp); }
   int GetYear() { return DateTimeStatic::Year(timestamp); }
   long GetTime() { return timestamp; };
-  ENUM_DATATYPE GetDataType(int _mode) { return values[_mode].GetDataType(); }
+  ENUM_DATATYPE GetDataType(int _mode) { return GetEntryValue(_mode).GetDataType(); }
   ushort GetDataTypeFlags(ENUM_DATATYPE _dt) {
     switch (_dt) {
       case TYPE_BOOL:
@@ -348,7 +364,33 @@ struct IndicatorDataEntry {
     return INDI_ENTRY_FLAG_NONE;
   }
   // Setters.
-  bool Resize(int _size = 0) { return _size > 0 ? ArrayResize(values, _size) > 0 : true; }
+  bool Resize(int _size = 0) {
+    if (_size <= 0) {
+      return true;
+    }
+    size = _size;
+    if (_size > INDI_DATA_ENTRY_INLINE_VALUES) {
+      return ArrayResize(values_ext, _size - INDI_DATA_ENTRY_INLINE_VALUES) > 0;
+    } else if (ArraySize(values_ext) > 0) {
+      ArrayFree(values_ext);
+    }
+    return true;
+  }
+  template <typename T>
+  void SetValue(int _index, T _value) {
+    if (_index < INDI_DATA_ENTRY_INLINE_VALUES) {
+      values[_index].Set(_value);
+    } else {
+      values_ext[_index - INDI_DATA_ENTRY_INLINE_VALUES].Set(_value);
+    }
+  }
+  void SetEntryValue(int _index, IndicatorDataEntryValue &_value) {
+    if (_index < INDI_DATA_ENTRY_INLINE_VALUES) {
+      values[_index] = _value;
+    } else {
+      values_ext[_index - INDI_DATA_ENTRY_INLINE_VALUES] = _value;
+    }
+  }
   // Value flag methods for bitwise operations.
   bool CheckFlag(INDICATOR_ENTRY_FLAGS _prop) { return CheckFlags(_prop); }
   bool CheckFlags(unsigned short _flags) { return (flags & _flags) != 0; }
@@ -369,18 +411,17 @@ struct IndicatorDataEntry {
   bool IsValid() { return CheckFlags(INDI_ENTRY_FLAG_IS_VALID); }
   // Serializers.
   void SerializeStub(int _n1 = 1, int _n2 = 1, int _n3 = 1, int _n4 = 1, int _n5 = 1) {
-    ArrayResize(values, _n1);
+    Resize(_n1);
     for (int i = 0; i < _n1; ++i) {
-      values[i] = (int)1;
+      SetValue(i, (int)1);
     }
   }
   SerializerNodeType Serialize(Serializer &_s);
   template <typename T>
   string ToCSV() {
-    int _asize = ArraySize(values);
     string _result = "";
-    for (int i = 0; i < _asize; i++) {
-      _result += StringFormat("%s%s", (string)values[i].Get<T>(), i < _asize ? "," : "");
+    for (int i = 0; i < size; i++) {
+      _result += StringFormat("%s%s", (string)GetValue<T>(i), i < size ? "," : "");
     }
     return _result;
   }
@@ -32,7 +32,7 @@ class Serializer;
 
 /* Method to serialize IndicatorDataEntry structure. */
 SerializerNodeType IndicatorDataEntry::Serialize(Serializer &_s) {
-  int _asize = ArraySize(values);
+  int _asize = size;
   _s.Pass(THIS_REF, "datetime", timestamp, SERIALIZER_FIELD_FLAG_DYNAMIC);
   _s.Pass(THIS_REF, "flags", flags, SERIALIZER_FIELD_FLAG_DYNAMIC);
   for (int i = 0; i < _asize; i++) {
@@ -40,13 +40,16 @@ SerializerNodeType IndicatorDataEntry::Serialize(Serializer &_s) {
     // this work? _s.Pass(THIS_REF, (string)i, GetEntry(i), SERIALIZER_FIELD_FLAG_DYNAMIC |
     // SERIALIZER_FIELD_FLAG_FEATURE); // Can this work?
 
-    switch (values[i].GetDataType()) {
+    // Passing a copy, as values beyond the inline ones are kept in a separate array.
+    IndicatorDataEntryValue _entry_value = GetEntryValue(i);
+
+    switch (_entry_value.GetDataType()) {
       case TYPE_DOUBLE:
-        _s.Pass(THIS_REF, (string)i, values[i].value.vdbl,
+        _s.Pass(THIS_REF, (string)i, _entry_value.value.vdbl,
                 SERIALIZER_FIELD_FLAG_DYNAMIC | SERIALIZER_FIELD_FLAG_FEATURE);
         break;
       case TYPE_FLOAT:
-        _s.Pass(THIS_REF, (string)i, values[i].value.vflt,
+        _s.Pass(THIS_REF, (string)i, _entry_value.value.vflt,
                 SERIALIZER_FIELD_FLAG_DYNAMIC | SERIALIZER_FIELD_FLAG_FEATURE);
         break;
       case TYPE_INT:
@@ -54,11 +57,11 @@ SerializerNodeType IndicatorDataEntry::Serialize(Serializer &_s) {
         if (CheckFlags(INDI_ENTRY_FLAG_IS_BITWISE)) {
           // Split for each bit and pass 0 or 1.
           for (int j = 0; j < sizeof(int) * 8; ++j) {
-            int _value = (values[i].value.vint & (1 << j)) != 0;
+            int _value = (_entry_value.value.vint & (1 << j)) != 0;
             _s.Pass(THIS_REF, StringFormat("%d@%d", i, j), _value, SERIALIZER_FIELD_FLAG_FEATURE);
           }
         } else {
-          _s.Pass(THIS_REF, (string)i, values[i].value.vint,
+          _s.Pass(THIS_REF, (string)i, _entry_value.value.vint,
                   SERIALIZER_FIELD_FLAG_DYNAMIC | SERIALIZER_FIELD_FLAG_FEATURE);
         }
         break;
@@ -74,7 +77,7 @@ SerializerNodeType IndicatorDataEntry::Serialize(Serializer &_s) {
           */
           SetUserError(ERR_INVALID_PARAMETER);
         } else {
-          _s.Pass(THIS_REF, (string)i, values[i].value.vlong,
+          _s.Pass(THIS_REF, (string)i, _entry_value.value.vlong,
                   SERIALIZER_FIELD_FLAG_DYNAMIC | SERIALIZER_FIELD_FLAG_FEATURE);
         }
         break;
@@ -82,6 +85,7 @@ SerializerNodeType IndicatorDataEntry::Serialize(Serializer &_s) {
         SetUserError(ERR_INVALID_PARAMETER);
         break;
     }
+    SetEntryValue(i, _entry_value);
   }
   return SerializerNodeObject;
 }
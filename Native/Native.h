@@ -0,0 +1,306 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Native (C++) backend of the platform functions related to history, market, time and account.
+ *
+ * Implements the external functions declared by *.extern.h files against the simulated market (see NativeMarket),
+ * replaying local history and tick files, so the framework can run headless. All the definitions are inline, so it
+ * can be included into any number of translation units.
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+
+// Prevents processing this includes file for the second time.
+#ifndef NATIVE_H
+#define NATIVE_H
+
+// Includes.
+#include "../Account/Account.extern.h"
+#include "../Array.extern.h"
+#include "../Chart.extern.h"
+#include "../DateTime.extern.h"
+#include "../Math.extern.h"
+#include "../String.extern.h"
+#include "../SymbolInfo.extern.h"
+#include "NativeMarket.h"
+
+// Defines external global variables.
+inline string _Symbol;
+
+/* Implements datetime class */
+
+inline datetime::datetime() : dt(0) {}
+inline datetime::datetime(const long& _time) : dt((time_t)_time) {}
+inline datetime::datetime(const int& _time) : dt((time_t)_time) {}
+inline bool datetime::operator==(const int _time) const { return dt == (time_t)_time; }
+inline bool datetime::operator==(const datetime& _time) const { return dt == _time.dt; }
+inline bool datetime::operator<(const int _time) const { return dt < (time_t)_time; }
+inline bool datetime::operator>(const int _time) const { return dt > (time_t)_time; }
+inline bool datetime::operator<(const datetime& _time) { return dt < _time.dt; }
+inline bool datetime::operator>(const datetime& _time) { return dt > _time.dt; }
+inline datetime::operator long() const { return (long)dt; }
+
+/* Implements time functions */
+
+inline datetime TimeCurrent() { return datetime(NativeMarket::GetInstance()->GetTime()); }
+inline datetime TimeGMT() { return TimeCurrent(); }
+inline datetime TimeTradeServer() { return TimeCurrent(); }
+
+/* Implements history functions */
+
+/**
+ * Copies given field of the bars starting from the given series shift, in chronological order.
+ */
+template <typename T, typename F>
+int NativeCopy(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(T, _out),
+               F MqlRates::*_field) {
+  NativeHistory* _history = NativeMarket::GetInstance()->GetHistory(_symbol, _tf);
+  std::vector<MqlRates> _rates;
+  int _copied = _history != NULL ? _history->Copy(_start_pos, _count, _rates) : -1;
+  _out.str().resize(_copied > 0 ? _copied : 0);
+  for (int i = 0; i < _copied; ++i) {
+    _out.str()[i] = (T)(_rates[i].*_field);
+  }
+  return _copied;
+}
+
+inline int Bars(string _symbol, ENUM_TIMEFRAMES _tf) {
+  NativeHistory* _history = NativeMarket::GetInstance()->GetHistory(_symbol, _tf);
+  return _history != NULL ? _history->Size() : 0;
+}
+
+inline int CopyRates(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(MqlRates, _out)) {
+  NativeHistory* _history = NativeMarket::GetInstance()->GetHistory(_symbol, _tf);
+  int _copied = _history != NULL ? _history->Copy(_start_pos, _count, _out.str()) : -1;
+  if (_copied < 0) {
+    _out.str().clear();
+  }
+  return _copied;
+}
+
+inline int CopyTime(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(datetime, _out)) {
+  return NativeCopy(_symbol, _tf, _start_pos, _count, _out, &MqlRates::time);
+}
+
+inline int CopyTime(string _symbol, ENUM_TIMEFRAMES _tf, datetime _start_time, int _count, ARRAY_REF(datetime, _out)) {
+  NativeHistory* _history = NativeMarket::GetInstance()->GetHistory(_symbol, _tf);
+  // Bars are copied up to the newest bar opened at the start time.
+  int _newer = _history != NULL ? _history->Size() - _history->LowerBound((long)_start_time + 1) : 0;
+  return _history != NULL ? NativeCopy(_symbol, _tf, _newer, _count, _out, &MqlRates::time) : -1;
+}
+
+inline int CopyTime(string _symbol, ENUM_TIMEFRAMES _tf, datetime _start_time, datetime _stop_time,
+             ARRAY_REF(datetime, _out)) {
+  NativeHistory* _history = NativeMarket::GetInstance()->GetHistory(_symbol, _tf);
+  std::vector<MqlRates> _rates;
+  int _copied = _history != NULL ? _history->Copy((long)_start_time, (long)_stop_time, _rates) : -1;
+  _out.str().resize(_copied > 0 ? _copied : 0);
+  for (int i = 0; i < _copied; ++i) {
+    _out.str()[i] = _rates[i].time;
+  }
+  return _copied;
+}
+
+inline int CopyOpen(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(double, _out)) {
+  return NativeCopy(_symbol, _tf, _start_pos, _count, _out, &MqlRates::open);
+}
+
+inline int CopyHigh(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(double, _out)) {
+  return NativeCopy(_symbol, _tf, _start_pos, _count, _out, &MqlRates::high);
+}
+
+inline int CopyLow(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(double, _out)) {
+  return NativeCopy(_symbol, _tf, _start_pos, _count, _out, &MqlRates::low);
+}
+
+inline int CopyClose(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(double, _out)) {
+  return NativeCopy(_symbol, _tf, _start_pos, _count, _out, &MqlRates::close);
+}
+
+inline int CopyTickVolume(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(long, _out)) {
+  return NativeCopy(_symbol, _tf, _start_pos, _count, _out, &MqlRates::tick_volume);
+}
+
+inline int CopyRealVolume(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(long, _out)) {
+  return NativeCopy(_symbol, _tf, _start_pos, _count, _out, &MqlRates::real_volume);
+}
+
+inline int CopySpread(string _symbol, ENUM_TIMEFRAMES _tf, int _start_pos, int _count, ARRAY_REF(int, _out)) {
+  return NativeCopy(_symbol, _tf, _start_pos, _count, _out, &MqlRates::spread);
+}
+
+/* Implements symbol functions */
+
+inline bool SymbolInfoTick(string _name, MqlTick& _tick) {
+  NativeSymbol* _symbol = NativeMarket::GetInstance()->GetSymbol(_name);
+  if (_symbol == NULL) {
+    return false;
+  }
+  _tick = _symbol->GetTick();
+  return true;
+}
+
+inline double SymbolInfoDouble(string _name, ENUM_SYMBOL_INFO_DOUBLE _prop_id) {
+  NativeSymbol* _symbol = NativeMarket::GetInstance()->GetSymbol(_name);
+  if (_symbol == NULL) {
+    return 0;
+  }
+  switch (_prop_id) {
+    case SYMBOL_BID:
+      return _symbol->GetTick().bid;
+    case SYMBOL_ASK:
+      return _symbol->GetTick().ask;
+    case SYMBOL_LAST:
+      return _symbol->GetTick().last;
+    case SYMBOL_POINT:
+    case SYMBOL_TRADE_TICK_SIZE:
+      return _symbol->GetPoint();
+    case SYMBOL_TRADE_CONTRACT_SIZE:
+      return 100000;
+    case SYMBOL_VOLUME_MIN:
+    case SYMBOL_VOLUME_STEP:
+      return 0.01;
+    case SYMBOL_VOLUME_MAX:
+      return 100;
+    default:
+      break;
+  }
+  return 0;
+}
+
+inline long SymbolInfoInteger(string _name, ENUM_SYMBOL_INFO_INTEGER _prop_id) {
+  NativeSymbol* _symbol = NativeMarket::GetInstance()->GetSymbol(_name);
+  if (_symbol == NULL) {
+    return 0;
+  }
+  const MqlTick& _tick = _symbol->GetTick();
+  switch (_prop_id) {
+    case SYMBOL_DIGITS:
+      return _symbol->GetDigits();
+    case SYMBOL_SPREAD:
+      return (long)round((_tick.ask - _tick.bid) / _symbol->GetPoint());
+    case SYMBOL_SPREAD_FLOAT:
+      return true;
+    case SYMBOL_TIME:
+      return (long)_tick.time;
+    case SYMBOL_TIME_MSC:
+      return _tick.time_msc;
+    case SYMBOL_VOLUME:
+      return (long)_tick.volume;
+    default:
+      break;
+  }
+  return 0;
+}
+
+/* Implements account functions */
+
+inline double AccountInfoDouble(ENUM_ACCOUNT_INFO_DOUBLE _prop_id) {
+  NativeMarket* _market = NativeMarket::GetInstance();
+  switch (_prop_id) {
+    case ACCOUNT_BALANCE:
+    case ACCOUNT_EQUITY:
+    case ACCOUNT_MARGIN_FREE:
+      // There are no positions, so equity and free margin equal the balance.
+      return _market->GetBalance() + (_prop_id != ACCOUNT_BALANCE ? _market->GetCredit() : 0);
+    case ACCOUNT_CREDIT:
+      return _market->GetCredit();
+    default:
+      break;
+  }
+  return 0;
+}
+
+inline long AccountInfoInteger(ENUM_ACCOUNT_INFO_INTEGER _prop_id) {
+  NativeMarket* _market = NativeMarket::GetInstance();
+  switch (_prop_id) {
+    case ACCOUNT_LOGIN:
+      return _market->GetLogin();
+    case ACCOUNT_LEVERAGE:
+      return _market->GetLeverage();
+    case ACCOUNT_CURRENCY_DIGITS:
+      return 2;
+    case ACCOUNT_TRADE_ALLOWED:
+    case ACCOUNT_TRADE_EXPERT:
+      return true;
+    default:
+      break;
+  }
+  return 0;
+}
+
+inline string AccountInfoString(ENUM_ACCOUNT_INFO_STRING _prop_id) {
+  switch (_prop_id) {
+    case ACCOUNT_CURRENCY:
+      return NativeMarket::GetInstance()->GetCurrency();
+    case ACCOUNT_COMPANY:
+    case ACCOUNT_SERVER:
+      return "Native";
+    default:
+      break;
+  }
+  return "";
+}
+
+/* Implements array functions */
+
+template <typename T>
+int ArraySize(const ARRAY_REF(T, _array)) {
+  return _array.size();
+}
+
+template <typename T>
+int ArrayResize(ARRAY_REF(T, _array), int _new_size, int _reserve_size) {
+  if (_reserve_size > 0) {
+    _array.str().reserve(_new_size + _reserve_size);
+  }
+  _array.str().resize(_new_size);
+  return _new_size;
+}
+
+/* Implements math functions */
+
+template <typename T>
+T MathRound(T value) {
+  return std::round(value);
+}
+
+template <typename T>
+T MathMax(T value1, T value2) {
+  return value1 > value2 ? value1 : value2;
+}
+
+template <typename T>
+T MathMin(T value1, T value2) {
+  return value1 < value2 ? value1 : value2;
+}
+
+/* Implements string functions */
+
+inline int StringLen(string string_value) { return (int)string_value.size(); }
+
+#endif  // NATIVE_H
+#endif
@@ -0,0 +1,281 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef NATIVE_HISTORY_H
+#define NATIVE_HISTORY_H
+
+// Includes standard libraries.
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+// Includes.
+#include "../Chart.extern.h"
+
+// Defines.
+#define NATIVE_HISTORY_HST_VERSION 401  // Version of HST files with records in MqlRates layout.
+
+/**
+ * Bars of a single symbol and time-frame, in chronological order.
+ *
+ * Used by the native (C++) backend of the platform functions. Bars are loaded from HST files (version 401, as
+ * written by MT4), aggregated from bars of a lower time-frame or formed by ticks.
+ */
+class NativeHistory {
+ protected:
+  // Symbol and time-frame of the bars.
+  string symbol;
+  ENUM_TIMEFRAMES tf;
+  // Digits of the prices.
+  int digits;
+  // Bars in chronological order.
+  std::vector<MqlRates> rates;
+
+ public:
+  /**
+   * Constructor.
+   */
+  NativeHistory(string _symbol = "", ENUM_TIMEFRAMES _tf = PERIOD_M1, int _digits = 5)
+      : symbol(_symbol), tf(_tf), digits(_digits) {}
+
+  /* Getters */
+
+  /**
+   * Returns symbol of the bars.
+   */
+  string GetSymbol() const { return symbol; }
+
+  /**
+   * Returns time-frame of the bars.
+   */
+  ENUM_TIMEFRAMES GetTf() const { return tf; }
+
+  /**
+   * Returns number of bars.
+   */
+  int Size() const { return (int)rates.size(); }
+
+  /**
+   * Returns bar at the given index (0 is the oldest bar).
+   */
+  const MqlRates& GetByIndex(int _index) const { return rates[_index]; }
+
+  /**
+   * Returns open time of the bar of the given time-frame which covers the given time.
+   */
+  static long GetBarTime(ENUM_TIMEFRAMES _tf, long _time) {
+    switch (_tf) {
+      case PERIOD_W1:
+        // Weeks start on Sunday, 1970-01-01 was Thursday.
+        return (_time + 4 * 86400) / 604800 * 604800 - 4 * 86400;
+      case PERIOD_MN1: {
+        time_t _t = (time_t)_time;
+        struct tm _tm;
+        gmtime_r(&_t, &_tm);
+        _tm.tm_mday = 1;
+        _tm.tm_hour = _tm.tm_min = _tm.tm_sec = 0;
+        return (long)timegm(&_tm);
+      }
+      default:
+        break;
+    }
+    long _seconds = (long)_tf * 60;
+    return _seconds > 0 ? _time / _seconds * _seconds : _time;
+  }
+
+  /**
+   * Returns index of the oldest bar opened at or after the given time (size if there is no such bar).
+   */
+  int LowerBound(long _time) const {
+    int _lo = 0, _hi = Size();
+    while (_lo < _hi) {
+      int _mid = (_lo + _hi) / 2;
+      if ((long)rates[_mid].time < _time) {
+        _lo = _mid + 1;
+      } else {
+        _hi = _mid;
+      }
+    }
+    return _lo;
+  }
+
+  /**
+   * Copies given number of bars starting from the given series shift, in chronological order.
+   *
+   * @return
+   *   Returns number of copied bars or -1 if there are no such bars.
+   */
+  int Copy(int _start_pos, int _count, std::vector<MqlRates>& _out) const {
+    int _size = Size();
+    if (_start_pos < 0 || _count <= 0 || _start_pos >= _size) {
+      return -1;
+    }
+    // As Copy*() functions do, range is cut at the oldest bar.
+    _count = _start_pos + _count > _size ? _size - _start_pos : _count;
+    _out.assign(rates.end() - _start_pos - _count, rates.end() - _start_pos);
+    return _count;
+  }
+
+  /**
+   * Copies bars opened within the given time range (both inclusive), in chronological order.
+   *
+   * @return
+   *   Returns number of copied bars or -1 if there are no such bars.
+   */
+  int Copy(long _from, long _to, std::vector<MqlRates>& _out) const {
+    int _start = LowerBound(_from < _to ? _from : _to);
+    int _end = LowerBound((_from < _to ? _to : _from) + 1);
+    if (_start >= _end) {
+      return -1;
+    }
+    _out.assign(rates.begin() + _start, rates.begin() + _end);
+    return _end - _start;
+  }
+
+  /* Modifiers */
+
+  /**
+   * Removes all the bars.
+   */
+  void Clear() { rates.clear(); }
+
+  /**
+   * Removes bars opened at or after the given time.
+   */
+  void Truncate(long _time) { rates.resize(LowerBound(_time)); }
+
+  /**
+   * Merges bar of the same or lower time-frame into the newest bar, or starts a new bar.
+   *
+   * Bars older than the newest one update the newest one, so the history stays ordered.
+   */
+  void Merge(const MqlRates& _bar) {
+    long _time = GetBarTime(tf, (long)_bar.time);
+    if (rates.empty() || _time > (long)rates.back().time) {
+      rates.push_back(_bar);
+      rates.back().time = _time;
+      return;
+    }
+    MqlRates& _last = rates.back();
+    _last.high = _bar.high > _last.high ? _bar.high : _last.high;
+    _last.low = _bar.low < _last.low ? _bar.low : _last.low;
+    _last.close = _bar.close;
+    _last.tick_volume += _bar.tick_volume;
+    _last.real_volume += _bar.real_volume;
+    _last.spread = _bar.spread;
+  }
+
+  /**
+   * Updates bars by the tick.
+   */
+  void AddTick(long _time, double _price, long _tick_volume, long _real_volume, int _spread) {
+    MqlRates _bar;
+    _bar.time = _time;
+    _bar.open = _bar.high = _bar.low = _bar.close = _price;
+    _bar.tick_volume = _tick_volume;
+    _bar.real_volume = _real_volume;
+    _bar.spread = _spread;
+    Merge(_bar);
+  }
+
+  /**
+   * Replaces bars with ones aggregated from the bars of a lower time-frame.
+   */
+  void Aggregate(const NativeHistory& _source) {
+    rates.clear();
+    for (int i = 0; i < _source.Size(); ++i) {
+      Merge(_source.GetByIndex(i));
+    }
+  }
+
+  /**
+   * Loads bars from the HST file (version 401), replacing the current ones.
+   */
+  bool Load(string _path) {
+    FILE* _file = fopen(_path.c_str(), "rb");
+    if (_file == NULL) {
+      return false;
+    }
+    int _header[37];
+    bool _result = fread(_header, sizeof(int), 37, _file) == 37 && _header[0] == NATIVE_HISTORY_HST_VERSION;
+    if (_result) {
+      char _symbol[13] = {0};
+      memcpy(_symbol, (char*)_header + 68, 12);
+      symbol = _symbol;
+      tf = (ENUM_TIMEFRAMES)_header[20];
+      digits = _header[21];
+      rates.clear();
+      MqlRates _bar;
+      long _time;
+      int _spread;
+      // Records are packed, so fields are read one by one.
+      while (fread(&_time, 8, 1, _file) == 1 && fread(&_bar.open, 8, 1, _file) == 1 &&
+             fread(&_bar.high, 8, 1, _file) == 1 && fread(&_bar.low, 8, 1, _file) == 1 &&
+             fread(&_bar.close, 8, 1, _file) == 1 && fread(&_bar.tick_volume, 8, 1, _file) == 1 &&
+             fread(&_spread, 4, 1, _file) == 1 && fread(&_bar.real_volume, 8, 1, _file) == 1) {
+        _bar.time = _time;
+        _bar.spread = _spread;
+        rates.push_back(_bar);
+      }
+    }
+    fclose(_file);
+    return _result;
+  }
+
+  /**
+   * Saves bars into the HST file (version 401).
+   */
+  bool Save(string _path) const {
+    FILE* _file = fopen(_path.c_str(), "wb");
+    if (_file == NULL) {
+      return false;
+    }
+    int _header[37];
+    memset(_header, 0, sizeof(_header));
+    _header[0] = NATIVE_HISTORY_HST_VERSION;
+    strncpy((char*)_header + 4, "(C)opyright 2003, MetaQuotes Software Corp.", 64);
+    strncpy((char*)_header + 68, symbol.c_str(), 12);
+    _header[20] = (int)tf;
+    _header[21] = digits;
+    _header[22] = (int)time(NULL);
+    bool _result = fwrite(_header, sizeof(int), 37, _file) == 37;
+    for (int i = 0; _result && i < Size(); ++i) {
+      long _time = (long)rates[i].time;
+      int _spread = rates[i].spread;
+      _result = fwrite(&_time, 8, 1, _file) == 1 && fwrite(&rates[i].open, 8, 1, _file) == 1 &&
+                fwrite(&rates[i].high, 8, 1, _file) == 1 && fwrite(&rates[i].low, 8, 1, _file) == 1 &&
+                fwrite(&rates[i].close, 8, 1, _file) == 1 && fwrite(&rates[i].tick_volume, 8, 1, _file) == 1 &&
+                fwrite(&_spread, 4, 1, _file) == 1 && fwrite(&rates[i].real_volume, 8, 1, _file) == 1;
+    }
+    fclose(_file);
+    return _result;
+  }
+};
+
+#endif  // NATIVE_HISTORY_H
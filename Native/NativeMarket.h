@@ -0,0 +1,233 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef NATIVE_MARKET_H
+#define NATIVE_MARKET_H
+
+// Includes standard libraries.
+#include <vector>
+
+// Includes.
+#include "../SymbolInfo.extern.h"
+#include "NativeSymbol.h"
+
+/**
+ * Simulated market of the native (C++) backend of the platform functions.
+ *
+ * Keeps the replayed symbols, the simulated clock and the account. Ticks of all the symbols are replayed in the order
+ * of their time, and the clock is set to the time of the last replayed tick.
+ *
+ * @usage
+ *   NativeMarket* _market = NativeMarket::GetInstance();
+ *   _market->AddSymbol("EURUSD", 5)->GetSource().Load("EURUSD1.hst");
+ *   _market->Start(1577836800);  // 2020.01.01.
+ *   while (_market->Tick()) {
+ *     // OnTick() logic.
+ *   }
+ */
+class NativeMarket {
+ protected:
+  // Replayed symbols.
+  std::vector<NativeSymbol*> symbols;
+  // Symbol and time-frame of the chart (used by NULL symbol and PERIOD_CURRENT).
+  string chart_symbol;
+  ENUM_TIMEFRAMES chart_tf;
+  // Simulated clock, in milliseconds.
+  long time_msc;
+  // Account.
+  long login;
+  long leverage;
+  double balance;
+  double credit;
+  string currency;
+
+ public:
+  /**
+   * Constructor.
+   */
+  NativeMarket()
+      : chart_tf(PERIOD_M1), time_msc(0), login(0), leverage(100), balance(10000), credit(0), currency("USD") {}
+
+  /**
+   * Destructor.
+   */
+  ~NativeMarket() {
+    for (int i = 0; i < (int)symbols.size(); ++i) {
+      delete symbols[i];
+    }
+  }
+
+  /**
+   * Returns the instance.
+   */
+  static NativeMarket* GetInstance() {
+    static NativeMarket _instance;
+    return &_instance;
+  }
+
+  /* Getters */
+
+  /**
+   * Returns symbol of the given name or NULL if there's none. Empty name refers to the chart's symbol.
+   */
+  NativeSymbol* GetSymbol(string _name) {
+    _name = _name == "" ? chart_symbol : _name;
+    for (int i = 0; i < (int)symbols.size(); ++i) {
+      if (symbols[i]->GetName() == _name) {
+        return symbols[i];
+      }
+    }
+    return NULL;
+  }
+
+  /**
+   * Returns bars of the given symbol and time-frame formed up to the current time or NULL if there's no such symbol.
+   */
+  NativeHistory* GetHistory(string _name, ENUM_TIMEFRAMES _tf) {
+    NativeSymbol* _symbol = GetSymbol(_name);
+    return _symbol != NULL ? _symbol->GetHistory(_tf == PERIOD_CURRENT ? chart_tf : _tf) : NULL;
+  }
+
+  /**
+   * Returns symbol of the chart.
+   */
+  string GetChartSymbol() const { return chart_symbol; }
+
+  /**
+   * Returns time-frame of the chart.
+   */
+  ENUM_TIMEFRAMES GetChartTf() const { return chart_tf; }
+
+  /**
+   * Returns the current time.
+   */
+  long GetTime() const { return time_msc / 1000; }
+
+  /**
+   * Returns the current time in milliseconds.
+   */
+  long GetTimeMsc() const { return time_msc; }
+
+  /**
+   * Returns account's balance.
+   */
+  double GetBalance() const { return balance; }
+
+  /**
+   * Returns account's credit.
+   */
+  double GetCredit() const { return credit; }
+
+  /**
+   * Returns account's currency.
+   */
+  string GetCurrency() const { return currency; }
+
+  /**
+   * Returns account's leverage.
+   */
+  long GetLeverage() const { return leverage; }
+
+  /**
+   * Returns account's number.
+   */
+  long GetLogin() const { return login; }
+
+  /* Setters */
+
+  /**
+   * Sets symbol and time-frame of the chart.
+   */
+  void SetChart(string _symbol, ENUM_TIMEFRAMES _tf) {
+    chart_symbol = _symbol;
+    chart_tf = _tf;
+    _Symbol = _symbol;
+  }
+
+  /**
+   * Sets the account.
+   */
+  void SetAccount(double _balance, long _leverage = 100, string _currency = "USD", long _login = 0) {
+    balance = _balance;
+    leverage = _leverage;
+    currency = _currency;
+    login = _login;
+  }
+
+  /* Modifiers */
+
+  /**
+   * Adds symbol to replay. The first added symbol becomes the chart's symbol.
+   */
+  NativeSymbol* AddSymbol(string _name, int _digits = 5, int _spread = 10) {
+    NativeSymbol* _symbol = GetSymbol(_name);
+    if (_symbol == NULL) {
+      _symbol = new NativeSymbol(_name, _digits, _spread);
+      symbols.push_back(_symbol);
+    }
+    if (chart_symbol == "") {
+      SetChart(_name, chart_tf);
+    }
+    return _symbol;
+  }
+
+  /**
+   * Resets replay of all the symbols to the given time.
+   */
+  void Start(long _time) {
+    for (int i = 0; i < (int)symbols.size(); ++i) {
+      symbols[i]->Start(_time);
+    }
+    time_msc = _time * 1000;
+  }
+
+  /**
+   * Replays the next tick of the symbol whose tick comes first.
+   *
+   * @return
+   *   Returns false if there are no more ticks.
+   */
+  bool Tick() {
+    NativeSymbol* _next = NULL;
+    long _next_msc = 0;
+    MqlTick _tick;
+    for (int i = 0; i < (int)symbols.size(); ++i) {
+      if (symbols[i]->GetNextTick(_tick) && (_next == NULL || _tick.time_msc < _next_msc)) {
+        _next = symbols[i];
+        _next_msc = _tick.time_msc;
+      }
+    }
+    if (_next == NULL || !_next->NextTick()) {
+      return false;
+    }
+    time_msc = _next_msc > time_msc ? _next_msc : time_msc;
+    return true;
+  }
+};
+
+#endif  // NATIVE_MARKET_H
@@ -0,0 +1,286 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef NATIVE_SYMBOL_H
+#define NATIVE_SYMBOL_H
+
+// Includes standard libraries.
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+// Includes.
+#include "../Tick.struct.h"
+#include "NativeHistory.h"
+
+/**
+ * Market of a single symbol replayed by the native (C++) backend of the platform functions.
+ *
+ * Bars of the source history (M1) older than the start time form the initial history. From the start time on, ticks
+ * are replayed: ticks loaded from the tick file or, when there are none, four ticks generated from each source bar
+ * (open, low, high and close for bullish bar, or open, high, low and close for bearish one). Ticks update bars of all
+ * the time-frames in use, so the history never reveals prices after the current tick.
+ *
+ * Tick file is a sequence of records of the time in milliseconds (long), bid and ask prices (double) and volume (long).
+ */
+class NativeSymbol {
+ protected:
+  // Name of the symbol.
+  string name;
+  // Digits and point of the prices.
+  int digits;
+  double point;
+  // Spread in points, for ticks generated from bars without spread.
+  int spread;
+  // Source bars (M1), including bars after the start time.
+  NativeHistory source;
+  // Ticks to replay, if loaded.
+  std::vector<MqlTick> ticks;
+  // Position of the next tick to replay: index of the tick or of the source bar and of its generated tick.
+  int next_tick;
+  int next_bar;
+  int next_bar_tick;
+  // The last replayed tick.
+  MqlTick tick;
+  // Bars formed up to the last tick by time-frame.
+  std::map<int, NativeHistory*> histories;
+
+  /**
+   * Generates the given tick of the source bar.
+   */
+  void GetBarTick(const MqlRates& _bar, int _index, MqlTick& _tick) const {
+    bool _bullish = _bar.close >= _bar.open;
+    double _prices[4] = {_bar.open, _bullish ? _bar.low : _bar.high, _bullish ? _bar.high : _bar.low, _bar.close};
+    long _offsets[4] = {0, 15, 30, 59};
+    // Tick volume of the bar is split between its ticks.
+    long _volume = _bar.tick_volume / 4 + (_index == 3 ? _bar.tick_volume % 4 : 0);
+    _tick.time = (long)_bar.time + _offsets[_index];
+    _tick.time_msc = ((long)_bar.time + _offsets[_index]) * 1000;
+    _tick.bid = _prices[_index];
+    _tick.ask = _prices[_index] + (_bar.spread > 0 ? _bar.spread : spread) * point;
+    _tick.last = 0;
+    _tick.volume = (unsigned long)_volume;
+    _tick.volume_real = 0;
+    _tick.flags = 0;
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  NativeSymbol(string _name, int _digits = 5, int _spread = 10)
+      : name(_name),
+        digits(_digits),
+        point(pow(10.0, -_digits)),
+        spread(_spread),
+        source(_name, PERIOD_M1, _digits),
+        next_tick(0),
+        next_bar(0),
+        next_bar_tick(0),
+        tick(MqlTick()) {}
+
+  /**
+   * Destructor.
+   */
+  ~NativeSymbol() {
+    for (std::map<int, NativeHistory*>::iterator _iter = histories.begin(); _iter != histories.end(); ++_iter) {
+      delete _iter->second;
+    }
+  }
+
+  /* Getters */
+
+  /**
+   * Returns name of the symbol.
+   */
+  string GetName() const { return name; }
+
+  /**
+   * Returns digits of the prices.
+   */
+  int GetDigits() const { return digits; }
+
+  /**
+   * Returns point of the prices.
+   */
+  double GetPoint() const { return point; }
+
+  /**
+   * Returns the last replayed tick.
+   */
+  const MqlTick& GetTick() const { return tick; }
+
+  /**
+   * Returns source bars.
+   */
+  NativeHistory& GetSource() { return source; }
+
+  /**
+   * Returns bars of the given time-frame formed up to the last tick.
+   *
+   * History of a time-frame not used before is aggregated from M1 bars.
+   */
+  NativeHistory* GetHistory(ENUM_TIMEFRAMES _tf) {
+    std::map<int, NativeHistory*>::iterator _iter = histories.find((int)_tf);
+    if (_iter != histories.end()) {
+      return _iter->second;
+    }
+    NativeHistory* _history = new NativeHistory(name, _tf, digits);
+    if (_tf != PERIOD_M1) {
+      _history->Aggregate(*GetHistory(PERIOD_M1));
+    }
+    histories[(int)_tf] = _history;
+    return _history;
+  }
+
+  /**
+   * Peeks the next tick to replay.
+   *
+   * @return
+   *   Returns false if there are no more ticks.
+   */
+  bool GetNextTick(MqlTick& _tick) const {
+    if (!ticks.empty()) {
+      if (next_tick >= (int)ticks.size()) {
+        return false;
+      }
+      _tick = ticks[next_tick];
+      return true;
+    }
+    if (next_bar >= source.Size()) {
+      return false;
+    }
+    GetBarTick(source.GetByIndex(next_bar), next_bar_tick, _tick);
+    return true;
+  }
+
+  /* Modifiers */
+
+  /**
+   * Loads ticks to replay from the tick file.
+   */
+  bool LoadTicks(string _path) {
+    FILE* _file = fopen(_path.c_str(), "rb");
+    if (_file == NULL) {
+      return false;
+    }
+    ticks.clear();
+    MqlTick _tick = MqlTick();
+    long _volume;
+    while (fread(&_tick.time_msc, 8, 1, _file) == 1 && fread(&_tick.bid, 8, 1, _file) == 1 &&
+           fread(&_tick.ask, 8, 1, _file) == 1 && fread(&_volume, 8, 1, _file) == 1) {
+      _tick.time = _tick.time_msc / 1000;
+      _tick.volume = (unsigned long)_volume;
+      ticks.push_back(_tick);
+    }
+    fclose(_file);
+    return true;
+  }
+
+  /**
+   * Saves ticks into the tick file.
+   */
+  static bool SaveTicks(string _path, const std::vector<MqlTick>& _ticks) {
+    FILE* _file = fopen(_path.c_str(), "wb");
+    if (_file == NULL) {
+      return false;
+    }
+    bool _result = true;
+    for (int i = 0; _result && i < (int)_ticks.size(); ++i) {
+      long _volume = (long)_ticks[i].volume;
+      _result = fwrite(&_ticks[i].time_msc, 8, 1, _file) == 1 && fwrite(&_ticks[i].bid, 8, 1, _file) == 1 &&
+                fwrite(&_ticks[i].ask, 8, 1, _file) == 1 && fwrite(&_volume, 8, 1, _file) == 1;
+    }
+    fclose(_file);
+    return _result;
+  }
+
+  /**
+   * Resets the replay to the given time.
+   *
+   * Source bars older than the bar of the start time become the initial history.
+   */
+  void Start(long _time) {
+    for (std::map<int, NativeHistory*>::iterator _iter = histories.begin(); _iter != histories.end(); ++_iter) {
+      delete _iter->second;
+    }
+    histories.clear();
+    long _bar_time = NativeHistory::GetBarTime(PERIOD_M1, _time);
+    NativeHistory* _history = GetHistory(PERIOD_M1);
+    _history->Aggregate(source);
+    _history->Truncate(_bar_time);
+    next_bar = source.LowerBound(_bar_time);
+    next_bar_tick = 0;
+    next_tick = 0;
+    while (next_tick < (int)ticks.size() && ticks[next_tick].time_msc < _bar_time * 1000) {
+      ++next_tick;
+    }
+    tick = MqlTick();
+    if (_history->Size() > 0) {
+      // Until the first tick, the last known price is the close of the last bar.
+      const MqlRates& _last = _history->GetByIndex(_history->Size() - 1);
+      tick.time = (long)_last.time;
+      tick.time_msc = (long)_last.time * 1000;
+      tick.bid = _last.close;
+      tick.ask = _last.close + (_last.spread > 0 ? _last.spread : spread) * point;
+    }
+  }
+
+  /**
+   * Replays the next tick, updating bars of all the time-frames in use.
+   *
+   * @return
+   *   Returns false if there are no more ticks.
+   */
+  bool NextTick() {
+    if (!GetNextTick(tick)) {
+      return false;
+    }
+    long _real_volume = 0;
+    if (!ticks.empty()) {
+      ++next_tick;
+    } else {
+      _real_volume = next_bar_tick == 3 ? source.GetByIndex(next_bar).real_volume : 0;
+      if (++next_bar_tick == 4) {
+        next_bar_tick = 0;
+        ++next_bar;
+      }
+    }
+    // Ticks from the file count as single ticks.
+    long _tick_volume = ticks.empty() ? (long)tick.volume : 1;
+    int _spread = (int)round((tick.ask - tick.bid) / point);
+    for (std::map<int, NativeHistory*>::iterator _iter = histories.begin(); _iter != histories.end(); ++_iter) {
+      _iter->second->AddTick((long)tick.time, tick.bid, _tick_volume, ticks.empty() ? _real_volume : (long)tick.volume,
+                             _spread);
+    }
+    return true;
+  }
+};
+
+#endif  // NATIVE_SYMBOL_H
@@ -0,0 +1,105 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Test functionality of the native backend of the platform functions.
+ */
+
+// Includes standard libraries.
+#include <cstdlib>
+
+// Includes.
+#include "../Native.h"
+
+#define NATIVE_TEST_CHECK(cond, msg)              \
+  if (!(cond)) {                                  \
+    fprintf(stderr, "Test failed: %s\n", (msg)); \
+    return 1;                                     \
+  }
+
+int main(int argc, char **argv) {
+  // Generates random M1 bars, a day and a half.
+  long _start = 1577836800;  // 2020.01.01 00:00.
+  int _num_bars = 36 * 60;
+  NativeHistory _bars("EURUSD", PERIOD_M1, 5);
+  double _price = 1.1;
+  for (int i = 0; i < _num_bars; ++i) {
+    MqlRates _bar;
+    _bar.time = _start + i * 60;
+    _bar.open = _price;
+    _price += (rand() % 21 - 10) * 0.00001;
+    _bar.close = _price;
+    _bar.high = (_bar.open > _bar.close ? _bar.open : _bar.close) + (rand() % 5) * 0.00001;
+    _bar.low = (_bar.open < _bar.close ? _bar.open : _bar.close) - (rand() % 5) * 0.00001;
+    _bar.tick_volume = 1 + rand() % 100;
+    _bar.spread = 10;
+    _bar.real_volume = 0;
+    _bars.Merge(_bar);
+  }
+  string _path = "NativeTest_EURUSD1.hst";
+  NATIVE_TEST_CHECK(_bars.Save(_path), "Cannot save HST file!");
+
+  NativeMarket *_market = NativeMarket::GetInstance();
+  NativeSymbol *_symbol = _market->AddSymbol("EURUSD", 5);
+  NATIVE_TEST_CHECK(_symbol->GetSource().Load(_path), "Cannot load HST file!");
+  NATIVE_TEST_CHECK(_symbol->GetSource().Size() == _num_bars, "Wrong number of loaded bars!");
+  remove(_path.c_str());
+
+  // History before the start time is available at once.
+  _market->Start(_start + 24 * 3600);
+  NATIVE_TEST_CHECK(Bars(_Symbol, PERIOD_M1) == 24 * 60, "Wrong number of M1 bars before the start!");
+  NATIVE_TEST_CHECK(Bars(_Symbol, PERIOD_H1) == 24, "Wrong number of H1 bars before the start!");
+  NATIVE_TEST_CHECK(Bars("GBPUSD", PERIOD_M1) == 0, "Unknown symbol shouldn't have bars!");
+
+  // Replays ticks, checking that bars never reveal the future.
+  int _ticks = 0;
+  while (_market->Tick()) {
+    ++_ticks;
+    MqlTick _tick;
+    ARRAY(double, _close);
+    NATIVE_TEST_CHECK(SymbolInfoTick(_Symbol, _tick), "Cannot get the tick!");
+    NATIVE_TEST_CHECK(CopyClose(_Symbol, PERIOD_H1, 0, 1, _close) == 1 && _close[0] == _tick.bid,
+                      "Forming bar should close at the tick's price!");
+    NATIVE_TEST_CHECK((long)TimeCurrent() == (long)_tick.time, "Clock should follow the ticks!");
+  }
+  NATIVE_TEST_CHECK(_ticks == 4 * 12 * 60, "Wrong number of replayed ticks!");
+
+  // Bars formed by ticks match bars aggregated from the source.
+  NativeHistory _h1("EURUSD", PERIOD_H1, 5);
+  _h1.Aggregate(_symbol->GetSource());
+  ARRAY(MqlRates, _rates);
+  NATIVE_TEST_CHECK(CopyRates(_Symbol, PERIOD_H1, 0, 100, _rates) == 36, "Wrong number of H1 bars!");
+  for (int i = 0; i < 36; ++i) {
+    const MqlRates &_bar = _h1.GetByIndex(i);
+    NATIVE_TEST_CHECK((long)_rates[i].time == (long)_bar.time && _rates[i].open == _bar.open &&
+                          _rates[i].high == _bar.high && _rates[i].low == _bar.low && _rates[i].close == _bar.close &&
+                          _rates[i].tick_volume == _bar.tick_volume,
+                      "Wrong H1 bar!");
+  }
+  ARRAY(datetime, _times);
+  NATIVE_TEST_CHECK(CopyTime(_Symbol, PERIOD_H1, datetime(_start + 3600), datetime(_start + 3 * 3600), _times) == 3,
+                    "Wrong number of bars within the time range!");
+  NATIVE_TEST_CHECK(AccountInfoDouble(ACCOUNT_BALANCE) > 0, "Account should have balance!");
+  printf("Replayed %d ticks.\n", _ticks);
+  return 0;
+}
@@ -137,6 +137,478 @@ struct PatternBitwise {
   void Reset() { ArrayResize(v, 0); }
 };
 
+/**
+ * Struct for calculating patterns of the series of candles.
+ *
+ * Prices of the candles are kept as separate arrays, along with the quantities shared between patterns (body, range,
+ * wicks, median, pivots, etc.), which are calculated once per candle when it is set. Patterns are then calculated from
+ * those arrays for all the sizes, each bit by plain comparisons combined without branching, so the loops over candles
+ * (see GetPatterns()) can be vectorized by the compiler.
+ *
+ * Candles are indexed as series (0 is the newest), so pattern at the given index uses the candle at that index and the
+ * older ones, the same as the PatternCandle* structs do with their arrays of candles.
+ */
+struct PatternBars {
+ protected:
+  // Prices and times of the candles.
+  ARRAY(datetime, time);
+  ARRAY(float, open);
+  ARRAY(float, high);
+  ARRAY(float, low);
+  ARRAY(float, close);
+  // Quantities shared between patterns.
+  ARRAY(float, body);
+  ARRAY(float, body_abs);
+  ARRAY(float, body_pct);
+  ARRAY(float, change_pct);
+  ARRAY(float, range);
+  ARRAY(float, min_oc);
+  ARRAY(float, max_oc);
+  ARRAY(float, median);
+  ARRAY(float, pivot);
+  ARRAY(float, pivot_dm);
+  ARRAY(float, pivot_open);
+  ARRAY(float, weighted);
+  ARRAY(float, wick_lw);
+  ARRAY(float, wick_up);
+  ARRAY(float, wick_sum);
+  ARRAY(float, wick_lw_pct);
+  ARRAY(float, wick_up_pct);
+  ARRAY(short, type);
+
+  /**
+   * Returns the flag when condition is met, otherwise 0.
+   */
+  static unsigned int Flag(int _flag, bool _cond) { return (unsigned int)_flag & (0 - (unsigned int)_cond); }
+
+ public:
+  /**
+   * Struct constructor.
+   */
+  PatternBars(int _size = 0) { Resize(_size); }
+  PatternBars(const ARRAY_REF(BarOHLC, _c), int _count = -1) { Set(_c, _count); }
+
+  /* Getters */
+
+  /**
+   * Returns number of candles.
+   */
+  int Size() const { return ArraySize(close); }
+
+  /**
+   * Returns time of the candle.
+   */
+  datetime GetTime(int _index) const { return time[_index]; }
+
+  /**
+   * Returns 1-candle patterns of the candle.
+   */
+  unsigned int GetPattern1(int _i) const {
+    unsigned int _p = PATTERN_1CANDLE_NONE;
+    _p |= Flag(PATTERN_1CANDLE_BEAR, type[_i] < 0);
+    _p |= Flag(PATTERN_1CANDLE_BULL, type[_i] > 0);
+    _p |= Flag(PATTERN_1CANDLE_BODY_GT_MED, min_oc[_i] > median[_i]);
+    _p |= Flag(PATTERN_1CANDLE_BODY_GT_PP, min_oc[_i] > pivot[_i]);
+    _p |= Flag(PATTERN_1CANDLE_BODY_GT_PP_DM, min_oc[_i] > pivot_dm[_i]);
+    _p |= Flag(PATTERN_1CANDLE_BODY_GT_PP_OPEN, min_oc[_i] > pivot_open[_i]);
+    _p |= Flag(PATTERN_1CANDLE_BODY_GT_WEIGHTED, min_oc[_i] > weighted[_i]);
+    _p |= Flag(PATTERN_1CANDLE_BODY_GT_WICKS, body[_i] > wick_sum[_i]);
+    _p |= Flag(PATTERN_1CANDLE_CHANGE_GT_01PC, change_pct[_i] > 0.1);
+    _p |= Flag(PATTERN_1CANDLE_CHANGE_GT_02PC, change_pct[_i] > 0.2);
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_GT_MED, close[_i] > median[_i]);
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_GT_PP, close[_i] > pivot[_i]);
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_GT_PP_DM, close[_i] > pivot_dm[_i]);
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_GT_PP_OPEN, close[_i] > pivot_open[_i]);
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_GT_WEIGHTED, close[_i] > weighted[_i]);
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_LT_PP, close[_i] < pivot[_i]);
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_LT_PP_DM, close[_i] < pivot_dm[_i]);
+    // Compared with the weighted price, as in PatternCandle1::CheckPattern().
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_LT_PP_OPEN, close[_i] < weighted[_i]);
+    _p |= Flag(PATTERN_1CANDLE_CLOSE_LT_WEIGHTED, close[_i] < weighted[_i]);
+    _p |= Flag(PATTERN_1CANDLE_HAS_WICK_LW, wick_lw_pct[_i] > 2);
+    _p |= Flag(PATTERN_1CANDLE_HAS_WICK_UP, wick_up_pct[_i] > 2);
+    _p |= Flag(PATTERN_1CANDLE_IS_DOJI_DRAGON, wick_lw_pct[_i] > 95);
+    _p |= Flag(PATTERN_1CANDLE_IS_DOJI_GRAVE, wick_up_pct[_i] > 95);
+    _p |= Flag(PATTERN_1CANDLE_IS_HAMMER_INV, (wick_up_pct[_i] > body_pct[_i] * 2) & (wick_lw_pct[_i] < 2));
+    _p |= Flag(PATTERN_1CANDLE_IS_HAMMER_UP, (wick_lw_pct[_i] > body_pct[_i] * 2) & (wick_up_pct[_i] < 2));
+    _p |= Flag(PATTERN_1CANDLE_IS_HANGMAN, (wick_lw_pct[_i] > body_pct[_i] * 3) & (wick_up_pct[_i] < 2));
+    _p |= Flag(PATTERN_1CANDLE_IS_LONG_SHADOW_LW, wick_lw_pct[_i] > 60);
+    _p |= Flag(PATTERN_1CANDLE_IS_LONG_SHADOW_UP, wick_up_pct[_i] > 60);
+    _p |= Flag(PATTERN_1CANDLE_IS_MARUBOZU, body_pct[_i] > 96);
+    _p |= Flag(PATTERN_1CANDLE_IS_SHAVEN_LW, (wick_up_pct[_i] > 50) & (wick_lw_pct[_i] < 2));
+    _p |= Flag(PATTERN_1CANDLE_IS_SHAVEN_UP, (wick_lw_pct[_i] > 50) & (wick_up_pct[_i] < 2));
+    _p |= Flag(PATTERN_1CANDLE_IS_SPINNINGTOP,
+               (body_pct[_i] < 30) & (wick_lw_pct[_i] > 20) & (wick_up_pct[_i] > 20));
+    return _p;
+  }
+
+  /**
+   * Returns 2-candle patterns of the candle and the previous one.
+   */
+  unsigned int GetPattern2(int _i) const {
+    int _j = _i + 1;
+    bool _hoc_gt_high = max_oc[_i] > high[_j];
+    bool _hoc_gt_hoc = max_oc[_i] > max_oc[_j];
+    bool _high_gt_high = high[_i] > high[_j];
+    bool _high_gt_hoc = high[_i] > max_oc[_j];
+    bool _loc_lt_loc = min_oc[_i] < min_oc[_j];
+    bool _loc_lt_low = min_oc[_i] < low[_j];
+    bool _low_lt_loc = low[_i] < min_oc[_j];
+    bool _low_lt_low = low[_i] < low[_j];
+    bool _body_in_body = !_hoc_gt_hoc & !_loc_lt_loc;
+    bool _range_in_body = !_high_gt_hoc & !_low_lt_loc;
+    unsigned int _p = PATTERN_2CANDLE_NONE;
+    _p |= Flag(PATTERN_2CANDLE_BEARS, (type[_i] < 0) & (type[_j] < 0));
+    _p |= Flag(PATTERN_2CANDLE_BODY_GT_BODY, body_abs[_i] > body_abs[_j]);
+    _p |= Flag(PATTERN_2CANDLE_BULLS, (type[_i] > 0) & (type[_j] > 0));
+    _p |= Flag(PATTERN_2CANDLE_CLOSE_GT_CLOSE, close[_i] > close[_j]);
+    _p |= Flag(PATTERN_2CANDLE_CLOSE_GT_HIGH, close[_i] > high[_j]);
+    _p |= Flag(PATTERN_2CANDLE_CLOSE_LT_LOW, close[_i] < low[_j]);
+    _p |= Flag(PATTERN_2CANDLE_HOC_GT_HIGH, _hoc_gt_high);
+    _p |= Flag(PATTERN_2CANDLE_HOC_GT_HOC, _hoc_gt_hoc);
+    _p |= Flag(PATTERN_2CANDLE_HIGH_GT_HIGH, _high_gt_high);
+    _p |= Flag(PATTERN_2CANDLE_HIGH_GT_HOC, _high_gt_hoc);
+    _p |= Flag(PATTERN_2CANDLE_LOC_LT_LOC, _loc_lt_loc);
+    _p |= Flag(PATTERN_2CANDLE_LOC_LT_LOW, _loc_lt_low);
+    _p |= Flag(PATTERN_2CANDLE_LOW_LT_LOC, _low_lt_loc);
+    _p |= Flag(PATTERN_2CANDLE_LOW_LT_LOW, _low_lt_low);
+    _p |= Flag(PATTERN_2CANDLE_OPEN_GT_OPEN, open[_i] > open[_j]);
+    _p |= Flag(PATTERN_2CANDLE_PP_GT_PP, pivot[_i] > pivot[_j]);
+    _p |= Flag(PATTERN_2CANDLE_PP_GT_PP_OPEN, pivot[_i] > pivot_open[_j]);
+    _p |= Flag(PATTERN_2CANDLE_RANGE_DBL_RANGE, range[_i] > range[_j] * 2);
+    _p |= Flag(PATTERN_2CANDLE_RANGE_GT_RANGE, range[_i] > range[_j]);
+    _p |= Flag(PATTERN_2CANDLE_TIME_GAP_DAY, (time[_i] - time[_j]) > 24 * 60 * 60);
+    _p |= Flag(PATTERN_2CANDLE_WEIGHTED_GT_WEIGHTED, weighted[_i] > weighted[_j]);
+    _p |= Flag(PATTERN_2CANDLE_WICKS_DBL_WICKS, wick_sum[_i] > wick_sum[_j] * 2);
+    _p |= Flag(PATTERN_2CANDLE_WICKS_GT_WICKS, wick_sum[_i] > wick_sum[_j]);
+    _p |= Flag(PATTERN_2CANDLE_BODY_IN_BODY, _body_in_body);
+    _p |= Flag(PATTERN_2CANDLE_BODY_OUT_BODY, _hoc_gt_hoc & _loc_lt_loc);
+    _p |= Flag(PATTERN_2CANDLE_RANGE_IN_RANGE, !_high_gt_high & !_low_lt_low);
+    _p |= Flag(PATTERN_2CANDLE_RANGE_OUT_RANGE, _high_gt_high & _low_lt_low);
+    _p |= Flag(PATTERN_2CANDLE_BODY_IN_RANGE, !_hoc_gt_high & !_loc_lt_low);
+    _p |= Flag(PATTERN_2CANDLE_BODY_OUT_RANGE, _hoc_gt_high & _loc_lt_low);
+    _p |= Flag(PATTERN_2CANDLE_RANGE_IN_BODY, _range_in_body);
+    _p |= Flag(PATTERN_2CANDLE_RANGE_OUT_BODY, _high_gt_hoc & _low_lt_loc);
+    _p |= Flag(PATTERN_2CANDLE_HARAMI, _body_in_body & _range_in_body);
+    return _p;
+  }
+
+  /**
+   * Returns 3-candle patterns of the candle and the previous ones.
+   */
+  unsigned int GetPattern3(int _i) const {
+    int _j = _i + 1, _k = _i + 2;
+    unsigned int _p = PATTERN_3CANDLE_NONE;
+    _p |= Flag(PATTERN_3CANDLE_BEARS, (type[_i] < 0) & (type[_j] < 0) & (type[_k] < 0));
+    _p |= Flag(PATTERN_3CANDLE_BODY0_DBL_SUM, body_abs[_i] > (body_abs[_j] + body_abs[_k]) * 2);
+    _p |= Flag(PATTERN_3CANDLE_BODY0_GT_SUM, body_abs[_i] > body_abs[_j] + body_abs[_k]);
+    _p |= Flag(PATTERN_3CANDLE_BODY_DEC, (body_abs[_i] < body_abs[_j]) & (body_abs[_j] < body_abs[_k]));
+    _p |= Flag(PATTERN_3CANDLE_BODY_INC, (body_abs[_i] > body_abs[_j]) & (body_abs[_j] > body_abs[_k]));
+    _p |= Flag(PATTERN_3CANDLE_BULLS, (type[_i] > 0) & (type[_j] > 0) & (type[_k] > 0));
+    _p |= Flag(PATTERN_3CANDLE_CLOSE_DEC, (close[_i] < close[_j]) & (close[_j] < close[_k]));
+    _p |= Flag(PATTERN_3CANDLE_CLOSE_INC, (close[_i] > close[_j]) & (close[_j] > close[_k]));
+    _p |= Flag(PATTERN_3CANDLE_HIGH0_LT_LOW2, high[_i] < low[_k]);
+    _p |= Flag(PATTERN_3CANDLE_HIGH1_LT_PP, high[_j] < fmin(pivot[_i], pivot[_k]));
+    _p |= Flag(PATTERN_3CANDLE_HIGH_DEC, (high[_i] < high[_j]) & (high[_j] < high[_k]));
+    _p |= Flag(PATTERN_3CANDLE_HIGH_INC, (high[_i] > high[_j]) & (high[_j] > high[_k]));
+    _p |= Flag(PATTERN_3CANDLE_LOW0_GT_HIGH2, low[_i] > high[_k]);
+    _p |= Flag(PATTERN_3CANDLE_LOW1_GT_PP, low[_j] > fmax(pivot[_i], pivot[_k]));
+    _p |= Flag(PATTERN_3CANDLE_LOW_DEC, (low[_i] < low[_j]) & (low[_j] < low[_k]));
+    _p |= Flag(PATTERN_3CANDLE_LOW_INC, (low[_i] > low[_j]) & (low[_j] > low[_k]));
+    _p |= Flag(PATTERN_3CANDLE_OPEN0_GT_HIGH2, open[_i] > high[_k]);
+    _p |= Flag(PATTERN_3CANDLE_OPEN0_LT_LOW2, open[_i] < low[_k]);
+    _p |= Flag(PATTERN_3CANDLE_OPEN_DEC, (open[_i] < open[_j]) & (open[_j] < open[_k]));
+    _p |= Flag(PATTERN_3CANDLE_OPEN_INC, (open[_i] > open[_j]) & (open[_j] > open[_k]));
+    _p |= Flag(PATTERN_3CANDLE_PEAK, (high[_i] > fmax(high[_j], high[_k])) | (low[_i] < fmin(low[_j], low[_k])));
+    _p |= Flag(PATTERN_3CANDLE_PP_DEC, (pivot[_i] < pivot[_j]) & (pivot[_j] < pivot[_k]));
+    _p |= Flag(PATTERN_3CANDLE_PP_INC, (pivot[_i] > pivot[_j]) & (pivot[_j] > pivot[_k]));
+    _p |= Flag(PATTERN_3CANDLE_RANGE0_GT_SUM, range[_i] > (range[_j] + range[_k]));
+    _p |= Flag(PATTERN_3CANDLE_RANGE1_GT_SUM, range[_j] > (range[_i] + range[_k]));
+    _p |= Flag(PATTERN_3CANDLE_RANGE_DEC, (range[_i] < range[_j]) & (range[_j] < range[_k]));
+    _p |= Flag(PATTERN_3CANDLE_RANGE_INC, (range[_i] > range[_j]) & (range[_j] > range[_k]));
+    _p |= Flag(PATTERN_3CANDLE_WICKS0_DBL_SUM, wick_sum[_i] > (wick_sum[_j] + wick_sum[_k]) * 2);
+    _p |= Flag(PATTERN_3CANDLE_WICKS0_GT_BODY, wick_sum[_i] > body_abs[_j] + body_abs[_k]);
+    _p |= Flag(PATTERN_3CANDLE_WICKS0_GT_SUM, wick_sum[_i] > wick_sum[_j] + wick_sum[_k]);
+    _p |= Flag(PATTERN_3CANDLE_WICKS1_DBL_BODY, wick_sum[_j] > (body_abs[_i] + body_abs[_k]) * 2);
+    _p |= Flag(PATTERN_3CANDLE_WICKS1_GT_BODY, wick_sum[_j] > body_abs[_i] + body_abs[_k]);
+    return _p;
+  }
+
+  /**
+   * Returns 4-candle patterns of the candle and the previous ones.
+   */
+  unsigned int GetPattern4(int _i) const {
+    int _j = _i + 1, _k = _i + 2, _l = _i + 3;
+    bool _bear0 = open[_i] > close[_i], _bear1 = open[_j] > close[_j];
+    bool _bear2 = open[_k] > close[_k], _bear3 = open[_l] > close[_l];
+    bool _bull0 = open[_i] < close[_i], _bull1 = open[_j] < close[_j];
+    bool _bull2 = open[_k] < close[_k], _bull3 = open[_l] < close[_l];
+    bool _body0_gt_sum3 = body_abs[_i] > body_abs[_j] + body_abs[_k];
+    unsigned int _p = PATTERN_4CANDLE_NONE;
+    _p |= Flag(PATTERN_4CANDLE_BEARS, _bear0 & _bear1 & _bear2 & _bear3);
+    _p |= Flag(PATTERN_4CANDLE_BEAR_CONT, _bear0 & (low[_i] < low[_l]) & _body0_gt_sum3 & _bull1 & _bull2 & _bear3 &
+                                              (low[_l] < fmin(low[_k], low[_j])));
+    _p |= Flag(PATTERN_4CANDLE_BEAR_REV,
+               _bear0 & (min_oc[_i] < fmin3(low[_j], low[_k], low[_l])) & _bear1 & _bull2 & _bull3);
+    _p |= Flag(PATTERN_4CANDLE_BEBU_MIXED, (type[_i] != type[_j]) & (type[_j] != type[_k]) & (type[_k] != type[_l]));
+    _p |= Flag(PATTERN_4CANDLE_BODY0_GT_SUM, body_abs[_i] > body_abs[_j] + body_abs[_k] + body_abs[_l]);
+    _p |= Flag(PATTERN_4CANDLE_BODY_DEC,
+               (body_abs[_i] < body_abs[_j]) & (body_abs[_j] < body_abs[_k]) & (body_abs[_k] < body_abs[_l]));
+    _p |= Flag(PATTERN_4CANDLE_BODY_INC,
+               (body_abs[_i] > body_abs[_j]) & (body_abs[_j] > body_abs[_k]) & (body_abs[_k] > body_abs[_l]));
+    _p |= Flag(PATTERN_4CANDLE_BULLS, _bull0 & _bull1 & _bull2 & _bull3);
+    _p |= Flag(PATTERN_4CANDLE_BULL_CONT, _bull0 & (high[_i] > high[_l]) & _body0_gt_sum3 & _bear1 & _bear2 & _bull3 &
+                                              (high[_l] > fmax(high[_k], high[_j])));
+    // Requires the latest candle to be bullish, as in PatternCandle4::CheckPattern().
+    _p |= Flag(PATTERN_4CANDLE_BULL_REV,
+               _bull0 & (max_oc[_i] > fmax3(high[_j], high[_k], high[_l])) & _bull1 & _bear2 & _bear3);
+    _p |= Flag(PATTERN_4CANDLE_CLOSE_DEC, (close[_i] < close[_j]) & (close[_j] < close[_k]) & (close[_k] < close[_l]));
+    _p |= Flag(PATTERN_4CANDLE_CLOSE_INC, (close[_i] > close[_j]) & (close[_j] > close[_k]) & (close[_k] > close[_l]));
+    _p |= Flag(PATTERN_4CANDLE_HIGH_DEC, (high[_i] < high[_j]) & (high[_j] < high[_k]) & (high[_k] < high[_l]));
+    _p |= Flag(PATTERN_4CANDLE_HIGH_INC, (high[_i] > high[_j]) & (high[_j] > high[_k]) & (high[_k] > high[_l]));
+    _p |= Flag(PATTERN_4CANDLE_INV_HAMMER, _bull0 & _bull1 & _bear2 & _bear3 &
+                                               (fmax(wick_up[_j], wick_up[_k]) > wick_sum[_i] + wick_sum[_l]));
+    _p |= Flag(PATTERN_4CANDLE_LOW_DEC, (low[_i] < low[_j]) & (low[_j] < low[_k]) & (low[_k] < low[_l]));
+    _p |= Flag(PATTERN_4CANDLE_LOW_INC, (low[_i] > low[_j]) & (low[_j] > low[_k]) & (low[_k] > low[_l]));
+    _p |= Flag(PATTERN_4CANDLE_OPEN_DEC, (open[_i] < open[_j]) & (open[_j] < open[_k]) & (open[_k] < open[_l]));
+    _p |= Flag(PATTERN_4CANDLE_OPEN_INC, (open[_i] > open[_j]) & (open[_j] > open[_k]) & (open[_k] > open[_l]));
+    _p |= Flag(PATTERN_4CANDLE_PEAK, (high[_i] > fmax(fmax(high[_j], high[_k]), high[_l])) |
+                                         (low[_i] < fmin(fmin(low[_j], low[_k]), low[_l])));
+    _p |= Flag(PATTERN_4CANDLE_PP_DEC, (pivot[_i] < pivot[_j]) & (pivot[_j] < pivot[_k]) & (pivot[_k] < pivot[_l]));
+    _p |= Flag(PATTERN_4CANDLE_PP_INC, (pivot[_i] > pivot[_j]) & (pivot[_j] > pivot[_k]) & (pivot[_k] > pivot[_l]));
+    _p |= Flag(PATTERN_4CANDLE_RANGE0_GT_SUM, range[_i] > range[_j] + range[_k] + range[_l]);
+    _p |= Flag(PATTERN_4CANDLE_RANGE_DEC, (range[_i] < range[_j]) & (range[_j] < range[_k]) & (range[_k] < range[_l]));
+    _p |= Flag(PATTERN_4CANDLE_RANGE_INC, (range[_i] > range[_j]) & (range[_j] > range[_k]) & (range[_k] > range[_l]));
+    _p |= Flag(PATTERN_4CANDLE_SHOOT_STAR, _bear0 & _bear1 & _bull2 & _bull3 &
+                                               (fmax(wick_lw[_j], wick_lw[_k]) > wick_sum[_i] + wick_sum[_l]));
+    _p |= Flag(PATTERN_4CANDLE_TIME_GAPS, ((time[_i] - time[_j]) / 120 != (time[_j] - time[_k]) / 120) |
+                                              ((time[_j] - time[_k]) / 120 != (time[_k] - time[_l]) / 120));
+    _p |= Flag(PATTERN_4CANDLE_WICKS0_GT_SUM, wick_sum[_i] > wick_sum[_j] + wick_sum[_k] + wick_sum[_l]);
+    _p |= Flag(PATTERN_4CANDLE_WICKS_DEC,
+               (wick_sum[_i] < wick_sum[_j]) & (wick_sum[_j] < wick_sum[_k]) & (wick_sum[_k] < wick_sum[_l]));
+    _p |= Flag(PATTERN_4CANDLE_WICKS_GT_BODY, wick_sum[_i] + wick_sum[_j] + wick_sum[_k] + wick_sum[_l] >
+                                                  body_abs[_i] + body_abs[_j] + body_abs[_k] + body_abs[_l]);
+    _p |= Flag(PATTERN_4CANDLE_WICKS_INC,
+               (wick_sum[_i] > wick_sum[_j]) & (wick_sum[_j] > wick_sum[_k]) & (wick_sum[_k] > wick_sum[_l]));
+    _p |= Flag(PATTERN_4CANDLE_WICKS_UPPER, wick_up[_i] + wick_up[_j] + wick_up[_k] + wick_up[_l] >
+                                                wick_lw[_i] + wick_lw[_j] + wick_lw[_k] + wick_lw[_l]);
+    return _p;
+  }
+
+  /**
+   * Returns 5-candle patterns of the candle and the previous ones.
+   */
+  unsigned int GetPattern5(int _i) const {
+    int _j = _i + 1, _k = _i + 2, _l = _i + 3, _m = _i + 4;
+    bool _close0_peak = (close[_i] > fmax(fmax(fmax(close[_j], close[_k]), close[_l]), close[_m])) |
+                        (close[_i] < fmin(fmin(fmin(close[_j], close[_k]), close[_l]), close[_m]));
+    bool _open4_peak = (open[_m] > fmax(fmax(fmax(open[_j], open[_i]), open[_l]), open[_k])) |
+                       (open[_m] < fmin(fmin(fmin(open[_j], open[_i]), open[_l]), open[_k]));
+    unsigned int _p = PATTERN_5CANDLE_NONE;
+    _p |= Flag(PATTERN_5CANDLE_BODY0_DIFF_PEAK,
+               fabs(body[_j] - body[_i]) > fmax(fabs(body[_m] - body[_l]), fabs(body[_k] - body[_j])));
+    // Signed bodies, as in PatternCandle5::CheckPattern().
+    _p |= Flag(PATTERN_5CANDLE_BODY0_GT_SUM, body[_i] > body[_j] + body[_k] + body[_l] + body[_m]);
+    _p |= Flag(PATTERN_5CANDLE_CLOSE0_DIFF_PEAK,
+               fabs(close[_j] - close[_i]) > fmax(fabs(close[_m] - close[_l]), fabs(close[_k] - close[_j])));
+    _p |= Flag(PATTERN_5CANDLE_CLOSE0_PEAK, _close0_peak);
+    _p |= Flag(PATTERN_5CANDLE_CLOSE2_PEAK,
+               (close[_k] > fmax(fmax(fmax(close[_j], close[_i]), close[_l]), close[_m])) |
+                   (close[_k] < fmin(fmin(fmin(close[_j], close[_i]), close[_l]), close[_m])));
+    _p |= Flag(PATTERN_5CANDLE_HIGH0_DIFF_PEAK,
+               fabs(high[_j] - high[_i]) > fmax(fabs(high[_m] - high[_l]), fabs(high[_k] - high[_j])));
+    _p |= Flag(PATTERN_5CANDLE_HIGH0_PEAK, high[_i] > fmax(fmax(fmax(high[_j], high[_k]), high[_l]), high[_m]));
+    _p |= Flag(PATTERN_5CANDLE_HIGH2_PEAK, high[_k] > fmax(fmax(fmax(high[_j], high[_i]), high[_l]), high[_m]));
+    _p |= Flag(PATTERN_5CANDLE_HORN_BOTTOMS, (low[_j] < fmin(fmin(low[_i], low[_k]), low[_m])) |
+                                                 (low[_l] < fmin(fmin(low[_i], low[_k]), low[_m])));
+    _p |= Flag(PATTERN_5CANDLE_HORN_TOPS, (high[_j] > fmax(fmax(high[_i], high[_k]), high[_m])) |
+                                              (high[_l] > fmax(fmax(high[_i], high[_k]), high[_m])));
+    _p |= Flag(PATTERN_5CANDLE_LINE_STRIKE, (type[_i] != type[_j]) & (type[_j] == type[_k]) & (type[_k] == type[_l]) &
+                                                (type[_l] == type[_m]) & _close0_peak);
+    _p |= Flag(PATTERN_5CANDLE_LOW0_DIFF_PEAK,
+               fabs(low[_j] - low[_i]) > fmax(fabs(low[_m] - low[_l]), fabs(low[_k] - low[_j])));
+    _p |= Flag(PATTERN_5CANDLE_LOW0_PEAK, low[_i] < fmin(fmin(fmin(low[_j], low[_k]), low[_l]), low[_m]));
+    _p |= Flag(PATTERN_5CANDLE_LOW2_PEAK, low[_k] < fmin(fmin(fmin(low[_j], low[_i]), low[_l]), low[_m]));
+    _p |= Flag(PATTERN_5CANDLE_MAT_HOLD, (type[_j] == type[_k]) & (type[_k] == type[_l]) & (type[_i] == type[_m]) &
+                                             (type[_i] != type[_j]) & _close0_peak & _open4_peak);
+    _p |= Flag(PATTERN_5CANDLE_OPEN0_DIFF_PEAK,
+               fabs(open[_j] - open[_i]) > fmax(fabs(open[_m] - open[_l]), fabs(open[_k] - open[_j])));
+    _p |= Flag(PATTERN_5CANDLE_OPEN0_PEAK, (open[_i] > fmax(fmax(fmax(open[_j], open[_k]), open[_l]), open[_m])) |
+                                               (open[_i] < fmin(fmin(fmin(open[_j], open[_k]), open[_l]), open[_m])));
+    _p |= Flag(PATTERN_5CANDLE_OPEN2_PEAK, (open[_k] > fmax(fmax(fmax(open[_j], open[_i]), open[_l]), open[_m])) |
+                                               (open[_k] < fmin(fmin(fmin(open[_j], open[_i]), open[_l]), open[_m])));
+    _p |= Flag(PATTERN_5CANDLE_OPEN4_PEAK, _open4_peak);
+    _p |= Flag(PATTERN_5CANDLE_PP0_DIFF_PEAK,
+               fabs(pivot[_j] - pivot[_i]) > fmax(fabs(pivot[_m] - pivot[_l]), fabs(pivot[_k] - pivot[_j])));
+    _p |= Flag(PATTERN_5CANDLE_PP0_PEAK,
+               (pivot[_i] > fmax(fmax(fmax(pivot[_j], pivot[_k]), pivot[_l]), pivot[_m])) |
+                   (pivot[_i] < fmin(fmin(fmin(pivot[_j], pivot[_k]), pivot[_l]), pivot[_m])));
+    _p |= Flag(PATTERN_5CANDLE_PP2_PEAK,
+               (pivot[_k] > fmax(fmax(fmax(pivot[_j], pivot[_i]), pivot[_l]), pivot[_m])) |
+                   (pivot[_k] < fmin(fmin(fmin(pivot[_j], pivot[_i]), pivot[_l]), pivot[_m])));
+    _p |= Flag(PATTERN_5CANDLE_PP_DEC, (pivot[_i] < pivot[_j]) & (pivot[_j] < pivot[_k]) & (pivot[_k] < pivot[_l]) &
+                                           (pivot[_l] < pivot[_m]));
+    _p |= Flag(PATTERN_5CANDLE_PP_DEC_INC, (pivot[_l] < pivot[_m]) & (pivot[_i] > pivot[_j]));
+    _p |= Flag(PATTERN_5CANDLE_PP_INC, (pivot[_i] > pivot[_j]) & (pivot[_j] > pivot[_k]) & (pivot[_k] > pivot[_l]) &
+                                           (pivot[_l] > pivot[_m]));
+    _p |= Flag(PATTERN_5CANDLE_PP_INC_DEC, (pivot[_l] > pivot[_m]) & (pivot[_i] < pivot[_j]));
+    _p |= Flag(PATTERN_5CANDLE_RANGE0_DIFF_PEAK,
+               fabs(range[_j] - range[_i]) > fmax(fabs(range[_m] - range[_l]), fabs(range[_k] - range[_j])));
+    _p |= Flag(PATTERN_5CANDLE_RANGE0_GT_SUM, range[_i] > range[_j] + range[_k] + range[_l] + range[_m]);
+    _p |= Flag(PATTERN_5CANDLE_REVERSAL, ((type[_i] == type[_j]) & (type[_k] == type[_l]) & (type[_l] == type[_m]) &
+                                          (type[_j] != type[_k])) |
+                                             ((type[_i] == type[_j]) & (type[_j] == type[_k]) & (type[_l] == type[_m]) &
+                                              (type[_k] != type[_l])));
+    _p |= Flag(PATTERN_5CANDLE_WICKS0_DIFF_PEAK, fabs(wick_sum[_j] - wick_sum[_i]) >
+                                                     fmax(fabs(wick_sum[_m] - wick_sum[_l]),
+                                                          fabs(wick_sum[_k] - wick_sum[_j])));
+    _p |= Flag(PATTERN_5CANDLE_WICKS0_PEAK,
+               (wick_sum[_i] > fmax(fmax(fmax(wick_sum[_j], wick_sum[_k]), wick_sum[_l]), wick_sum[_m])) |
+                   (wick_sum[_i] < fmin(fmin(fmin(wick_sum[_j], wick_sum[_k]), wick_sum[_l]), wick_sum[_m])));
+    _p |= Flag(PATTERN_5CANDLE_WICKS2_PEAK,
+               (wick_sum[_k] > fmax(fmax(fmax(wick_sum[_j], wick_sum[_i]), wick_sum[_l]), wick_sum[_m])) |
+                   (wick_sum[_k] < fmin(fmin(fmin(wick_sum[_j], wick_sum[_i]), wick_sum[_l]), wick_sum[_m])));
+    return _p;
+  }
+
+  /**
+   * Returns patterns of the given size (number of candles) at the given candle.
+   *
+   * @return
+   *   Returns 0 when there are not enough older candles for the pattern.
+   */
+  unsigned int GetPattern(int _size, int _index = 0) const {
+    if (_index < 0 || _index + _size > Size()) {
+      return 0;
+    }
+    switch (_size) {
+      case 1:
+        return GetPattern1(_index);
+      case 2:
+        return GetPattern2(_index);
+      case 3:
+        return GetPattern3(_index);
+      case 4:
+        return GetPattern4(_index);
+      case 5:
+        return GetPattern5(_index);
+    }
+    // There are no patterns of more candles yet.
+    return 0;
+  }
+
+  /**
+   * Calculates patterns of the given size at all the candles with enough older candles (e.g., over the whole history
+   * in backtests).
+   *
+   * @param _out
+   *   Receives the patterns, as series (0 is the newest).
+   *
+   * @return
+   *   Returns number of calculated patterns.
+   */
+  int GetPatterns(int _size, ARRAY_REF(unsigned int, _out)) const {
+    int _count = _size > 0 ? MathMax(Size() - _size + 1, 0) : 0;
+    ArrayResize(_out, _count);
+    int i;
+    switch (_size) {
+      case 1:
+        for (i = 0; i < _count; ++i) _out[i] = GetPattern1(i);
+        break;
+      case 2:
+        for (i = 0; i < _count; ++i) _out[i] = GetPattern2(i);
+        break;
+      case 3:
+        for (i = 0; i < _count; ++i) _out[i] = GetPattern3(i);
+        break;
+      case 4:
+        for (i = 0; i < _count; ++i) _out[i] = GetPattern4(i);
+        break;
+      case 5:
+        for (i = 0; i < _count; ++i) _out[i] = GetPattern5(i);
+        break;
+      default:
+        for (i = 0; i < _count; ++i) _out[i] = 0;
+        break;
+    }
+    return _count;
+  }
+
+  /* Setters */
+
+  /**
+   * Resizes the series. New candles have to be set before calculating patterns at them.
+   */
+  void Resize(int _size) {
+    ArrayResize(time, _size);
+    ArrayResize(open, _size);
+    ArrayResize(high, _size);
+    ArrayResize(low, _size);
+    ArrayResize(close, _size);
+    ArrayResize(body, _size);
+    ArrayResize(body_abs, _size);
+    ArrayResize(body_pct, _size);
+    ArrayResize(change_pct, _size);
+    ArrayResize(range, _size);
+    ArrayResize(min_oc, _size);
+    ArrayResize(max_oc, _size);
+    ArrayResize(median, _size);
+    ArrayResize(pivot, _size);
+    ArrayResize(pivot_dm, _size);
+    ArrayResize(pivot_open, _size);
+    ArrayResize(weighted, _size);
+    ArrayResize(wick_lw, _size);
+    ArrayResize(wick_up, _size);
+    ArrayResize(wick_sum, _size);
+    ArrayResize(wick_lw_pct, _size);
+    ArrayResize(wick_up_pct, _size);
+    ArrayResize(type, _size);
+  }
+
+  /**
+   * Sets candle at the given index and calculates its shared quantities.
+   */
+  void Set(int _index, const BarOHLC& _c) {
+    time[_index] = _c.time;
+    open[_index] = _c.open;
+    high[_index] = _c.high;
+    low[_index] = _c.low;
+    close[_index] = _c.close;
+    body[_index] = _c.GetBody();
+    body_abs[_index] = _c.GetBodyAbs();
+    body_pct[_index] = _c.GetBodyInPct();
+    change_pct[_index] = _c.GetChangeInPct();
+    range[_index] = _c.GetRange();
+    min_oc[_index] = _c.GetMinOC();
+    max_oc[_index] = _c.GetMaxOC();
+    median[_index] = _c.GetMedian();
+    pivot[_index] = _c.GetPivot();
+    pivot_dm[_index] = _c.GetPivotDeMark();
+    pivot_open[_index] = _c.GetPivotWithOpen();
+    weighted[_index] = _c.GetWeighted();
+    wick_lw[_index] = _c.GetWickLower();
+    wick_up[_index] = _c.GetWickUpper();
+    wick_sum[_index] = _c.GetWickSum();
+    wick_lw_pct[_index] = _c.GetWickLowerInPct();
+    wick_up_pct[_index] = _c.GetWickUpperInPct();
+    type[_index] = _c.GetType();
+  }
+
+  /**
+   * Sets all the candles from the array, as series (0 is the newest).
+   *
+   * @param _count
+   *   Number of candles to set or -1 for the whole array.
+   */
+  void Set(const ARRAY_REF(BarOHLC, _c), int _count = -1) {
+    int _size = _count >= 0 ? MathMin(_count, ArraySize(_c)) : ArraySize(_c);
+    Resize(_size);
+    for (int i = 0; i < _size; ++i) {
+      Set(i, _c[i]);
+    }
+  }
+};
+
 // Struct for storing 1-candlestick patterns.
 struct PatternCandle {
   unsigned int pattern;
@@ -174,10 +646,9 @@ struct PatternCandle {
 struct PatternCandle1 : PatternCandle {
   PatternCandle1(unsigned int _pattern = 0) : PatternCandle(_pattern) {}
   PatternCandle1(const BarOHLC& _c) : PatternCandle(PATTERN_1CANDLE_NONE) {
-    for (int i = 0; i < sizeof(int) * 8; i++) {
-      ENUM_PATTERN_1CANDLE _enum = (ENUM_PATTERN_1CANDLE)(1 << i);
-      SetPattern(_enum, CheckPattern(_enum, _c));
-    }
+    PatternBars _bars(1);
+    _bars.Set(0, _c);
+    pattern = _bars.GetPattern1(0);
   }
   // Calculation methods.
   static bool CheckPattern(ENUM_PATTERN_1CANDLE _enum, const BarOHLC& _c) {
@@ -297,10 +768,8 @@ struct PatternCandle1 : PatternCandle {
 struct PatternCandle2 : PatternCandle {
   PatternCandle2(unsigned int _pattern = 0) : PatternCandle(_pattern) {}
   PatternCandle2(const BarOHLC& _c[]) : PatternCandle(PATTERN_2CANDLE_NONE) {
-    for (int i = 0; i < sizeof(int) * 8; i++) {
-      ENUM_PATTERN_2CANDLE _enum = (ENUM_PATTERN_2CANDLE)(1 << i);
-      SetPattern(_enum, CheckPattern(_enum, _c));
-    }
+    PatternBars _bars(_c, 2);
+    pattern = _bars.GetPattern(2);
   }
   // Calculation methods.
   static bool CheckPattern(ENUM_PATTERN_2CANDLE _enum, const BarOHLC& _c[]) {
@@ -406,10 +875,8 @@ struct PatternCandle2 : PatternCandle {
 struct PatternCandle3 : PatternCandle {
   PatternCandle3(unsigned int _pattern = 0) : PatternCandle(_pattern) {}
   PatternCandle3(const BarOHLC& _c[]) : PatternCandle(PATTERN_3CANDLE_NONE) {
-    for (int i = 0; i < sizeof(int) * 8; i++) {
-      ENUM_PATTERN_3CANDLE _enum = (ENUM_PATTERN_3CANDLE)(1 << i);
-      SetPattern(_enum, CheckPattern(_enum, _c));
-    }
+    PatternBars _bars(_c, 3);
+    pattern = _bars.GetPattern(3);
   }
   // Calculation methods.
   static bool CheckPattern(ENUM_PATTERN_3CANDLE _enum, const BarOHLC& _c[]) {
@@ -522,10 +989,8 @@ struct PatternCandle3 : PatternCandle {
 struct PatternCandle4 : PatternCandle {
   PatternCandle4(unsigned int _pattern = 0) : PatternCandle(_pattern) {}
   PatternCandle4(const BarOHLC& _c[]) : PatternCandle(PATTERN_4CANDLE_NONE) {
-    for (int i = 0; i < sizeof(int) * 8; i++) {
-      ENUM_PATTERN_4CANDLE _enum = (ENUM_PATTERN_4CANDLE)(1 << i);
-      SetPattern(_enum, CheckPattern(_enum, _c));
-    }
+    PatternBars _bars(_c, 4);
+    pattern = _bars.GetPattern(4);
   }
   // Calculation methods.
   static bool CheckPattern(ENUM_PATTERN_4CANDLE _enum, const BarOHLC& _c[]) {
@@ -688,10 +1153,8 @@ struct PatternCandle4 : PatternCandle {
 struct PatternCandle5 : PatternCandle {
   PatternCandle5(unsigned int _pattern = 0) : PatternCandle(_pattern) {}
   PatternCandle5(const BarOHLC& _c[]) : PatternCandle(PATTERN_5CANDLE_NONE) {
-    for (int i = 0; i < sizeof(int) * 8; i++) {
-      ENUM_PATTERN_5CANDLE _enum = (ENUM_PATTERN_5CANDLE)(1 << i);
-      SetPattern(_enum, CheckPattern(_enum, _c));
-    }
+    PatternBars _bars(_c, 5);
+    pattern = _bars.GetPattern(5);
   }
   // Calculation methods.
   static bool CheckPattern(ENUM_PATTERN_5CANDLE _enum, const BarOHLC& _c[]) {
@@ -955,16 +1418,46 @@ struct PatternEntry {
         pattern9(0),
         pattern10(0) {}
   PatternEntry(BarOHLC& _c[])
-      : pattern1(_c[0]),
-        pattern2(_c),
-        pattern3(_c),
-        pattern4(_c),
-        pattern5(_c),
-        pattern6(_c),
-        pattern7(_c),
-        pattern8(_c),
-        pattern9(_c),
-        pattern10(_c) {}
+      : pattern1(0),
+        pattern2(0),
+        pattern3(0),
+        pattern4(0),
+        pattern5(0),
+        pattern6(0),
+        pattern7(0),
+        pattern8(0),
+        pattern9(0),
+        pattern10(0) {
+    PatternBars _bars(_c);
+    Set(_bars, 0);
+  }
+  PatternEntry(const PatternBars& _bars, int _index = 0)
+      : pattern1(0),
+        pattern2(0),
+        pattern3(0),
+        pattern4(0),
+        pattern5(0),
+        pattern6(0),
+        pattern7(0),
+        pattern8(0),
+        pattern9(0),
+        pattern10(0) {
+    Set(_bars, _index);
+  }
+  // Setters.
+  // Sets patterns of all sizes at the given candle of the series.
+  void Set(const PatternBars& _bars, int _index = 0) {
+    pattern1.pattern = _bars.GetPattern(1, _index);
+    pattern2.pattern = _bars.GetPattern(2, _index);
+    pattern3.pattern = _bars.GetPattern(3, _index);
+    pattern4.pattern = _bars.GetPattern(4, _index);
+    pattern5.pattern = _bars.GetPattern(5, _index);
+    pattern6.pattern = _bars.GetPattern(6, _index);
+    pattern7.pattern = _bars.GetPattern(7, _index);
+    pattern8.pattern = _bars.GetPattern(8, _index);
+    pattern9.pattern = _bars.GetPattern(9, _index);
+    pattern10.pattern = _bars.GetPattern(10, _index);
+  }
   // Operator methods.
   unsigned int operator[](const int _index) const {
     switch (_index) {
@@ -0,0 +1,246 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Index of candle patterns for searching the history.
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file multiple times.
+#ifndef PATTERN_INDEX_H
+#define PATTERN_INDEX_H
+
+// Includes.
+#include "Pattern.struct.h"
+#include "Storage/Bitmap.h"
+
+// Defines.
+#define PATTERN_INDEX_SIZES 10  // Number of indexed pattern sizes (as in PatternEntry).
+
+/**
+ * Inverted index of candle patterns of the single timeframe.
+ *
+ * Candles are indexed by their position (0 is the oldest indexed candle). For each bit of each pattern size there is
+ * a compressed bitmap of positions of the candles having the pattern, so finding candles where patterns co-occur is
+ * the intersection of bitmaps (see Bitmap::And(), Or() and AndNot()) instead of rescanning the history. Matching
+ * positions are then converted into the candle times (see GetTimes()).
+ *
+ * Closed candles are appended as they come, so the index is updated incrementally.
+ */
+class PatternIndex {
+ protected:
+  // Timeframe of the indexed candles.
+  ENUM_TIMEFRAMES tf;
+  // Times of the indexed candles, by their position.
+  ARRAY(datetime, times);
+  // Positions of the candles with the pattern, as [(size - 1) * 32 + bit].
+  ARRAY(Bitmap, bitmaps);
+  // Positions of all the indexed candles.
+  Bitmap all;
+
+  /* Protected methods */
+
+  /**
+   * Appends candle of the given time.
+   *
+   * @return
+   *   Returns position of the candle or -1 if it isn't newer than the last indexed one.
+   */
+  int AddTime(datetime _time) {
+    int _position = ArraySize(times);
+    if (_position > 0 && (long)times[_position - 1] >= (long)_time) {
+      return -1;
+    }
+    ArrayResize(times, _position + 1, 1024);
+    times[_position] = _time;
+    all.Add(_position);
+    return _position;
+  }
+
+  /**
+   * Adds position of the candle to bitmaps of all the patterns it has.
+   */
+  void AddPattern(int _position, int _size, unsigned int _pattern) {
+    for (int i = 0; _pattern != 0; ++i, _pattern >>= 1) {
+      if ((_pattern & 1) != 0) {
+        bitmaps[(_size - 1) * 32 + i].Add(_position);
+      }
+    }
+  }
+
+ public:
+  /**
+   * Class constructor.
+   */
+  PatternIndex(ENUM_TIMEFRAMES _tf = PERIOD_CURRENT) : tf(_tf) { ArrayResize(bitmaps, PATTERN_INDEX_SIZES * 32); }
+
+  /* Getters */
+
+  /**
+   * Returns timeframe of the indexed candles.
+   */
+  ENUM_TIMEFRAMES GetTf() const { return tf; }
+
+  /**
+   * Returns number of indexed candles.
+   */
+  int Size() const { return ArraySize(times); }
+
+  /**
+   * Returns time of the indexed candle.
+   */
+  datetime GetTime(int _position) const { return times[_position]; }
+
+  /**
+   * Returns time of the newest indexed candle or 0 if there's none.
+   */
+  datetime GetLastTime() const { return Size() > 0 ? times[Size() - 1] : (datetime)0; }
+
+  /**
+   * Returns position of the first candle not older than the given time (Size() if there's none).
+   */
+  int GetPosition(datetime _time) const {
+    int _lo = 0, _hi = Size();
+    while (_lo < _hi) {
+      int _mid = (_lo + _hi) / 2;
+      if ((long)times[_mid] < (long)_time) {
+        _lo = _mid + 1;
+      } else {
+        _hi = _mid;
+      }
+    }
+    return _lo;
+  }
+
+  /**
+   * Selects candles having all the given patterns of the given size.
+   *
+   * @param _flags
+   *   Patterns of the given size, e.g. PATTERN_2CANDLE_BULLS | PATTERN_2CANDLE_HIGH_GT_HIGH.
+   */
+  void Select(int _size, int _flags, Bitmap& _out) const {
+    if (_size < 1 || _size > PATTERN_INDEX_SIZES) {
+      _out.Clear();
+      return;
+    }
+    if (_flags == 0) {
+      _out.Copy(all);
+      return;
+    }
+    unsigned int _pattern = (unsigned int)_flags;
+    for (int i = 0, _selected = 0; _pattern != 0; ++i, _pattern >>= 1) {
+      if ((_pattern & 1) != 0) {
+        if (_selected++ == 0) {
+          _out.Copy(bitmaps[(_size - 1) * 32 + i]);
+        } else {
+          Bitmap::And(_out, bitmaps[(_size - 1) * 32 + i], _out);
+        }
+      }
+    }
+  }
+
+  /**
+   * Selects all the indexed candles.
+   */
+  void SelectAll(Bitmap& _out) const { _out.Copy(all); }
+
+  /**
+   * Selects candles which aren't in the given selection.
+   */
+  void Not(const Bitmap& _selection, Bitmap& _out) const { Bitmap::AndNot(all, _selection, _out); }
+
+  /**
+   * Returns times of the selected candles, in the ascending order.
+   *
+   * @param _from
+   *   Time of the oldest candle to return.
+   * @param _to
+   *   Time of the newest candle to return or 0 for no limit.
+   *
+   * @return
+   *   Returns number of returned times.
+   */
+  int GetTimes(const Bitmap& _selection, ARRAY_REF(datetime, _out), datetime _from = 0, datetime _to = 0) const {
+    ARRAY(int, _positions);
+    int _total = _selection.ToArray(_positions);
+    int _first = GetPosition(_from);
+    int _last = (long)_to > 0 ? GetPosition((datetime)((long)_to + 1)) : Size();
+    int _count = 0;
+    ArrayResize(_out, _total);
+    for (int i = 0; i < _total; ++i) {
+      if (_positions[i] >= _first && _positions[i] < _last) {
+        _out[_count++] = times[_positions[i]];
+      }
+    }
+    ArrayResize(_out, _count);
+    return _count;
+  }
+
+  /* Modifiers */
+
+  /**
+   * Indexes patterns of the closed candle.
+   *
+   * @return
+   *   Returns false if candle isn't newer than the last indexed one.
+   */
+  bool Add(datetime _time, const PatternEntry& _entry) {
+    int _position = AddTime(_time);
+    if (_position == -1) {
+      return false;
+    }
+    for (int _size = 1; _size <= PATTERN_INDEX_SIZES; ++_size) {
+      AddPattern(_position, _size, _entry[_size]);
+    }
+    return true;
+  }
+
+  /**
+   * Indexes patterns of the candles of the series which are newer than the last indexed one.
+   *
+   * All the candles of the series should be closed ones.
+   *
+   * @return
+   *   Returns number of indexed candles.
+   */
+  int Add(const PatternBars& _bars) {
+    int _count = 0;
+    for (int i = _bars.Size() - 1; i >= 0; --i) {
+      int _position = AddTime(_bars.GetTime(i));
+      if (_position == -1) {
+        continue;
+      }
+      for (int _size = 1; _size <= PATTERN_INDEX_SIZES; ++_size) {
+        AddPattern(_position, _size, _bars.GetPattern(_size, i));
+      }
+      ++_count;
+    }
+    return _count;
+  }
+};
+
+#endif  // PATTERN_INDEX_H
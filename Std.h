@@ -31,6 +31,7 @@
 #include <iomanip>
 #include <locale>
 #include <sstream>
+#include <utility>
 #include <vector>
 #endif
 
@@ -170,6 +171,13 @@ class _cpp_array {
     m_isSeries = r.m_isSeries;
   }
 
+  _cpp_array(_cpp_array&& r) : m_data(std::move(r.m_data)), m_isSeries(r.m_isSeries) {}
+
+  void operator=(_cpp_array&& r) {
+    m_data = std::move(r.m_data);
+    m_isSeries = r.m_isSeries;
+  }
+
   /**
    * Returns pointer of first element (provides a way to iterate over array elements).
    */
@@ -190,6 +198,11 @@ class _cpp_array {
    */
   int size() const { return (int)m_data.size(); }
 
+  /**
+   * Returns underlying vector of the elements (in the order of the storage, regardless of IsSeries flag).
+   */
+  std::vector<T>& str() { return m_data; }
+
   /**
    * Checks whether
    */
@@ -225,6 +238,9 @@ class color {
 // MQL defines.
 #ifndef __MQL__
 #define WHOLE_ARRAY -1  // For processing the entire array.
+#ifndef _MSC_VER
+#define __FUNCSIG__ __PRETTY_FUNCTION__
+#endif
 #endif
 
 // Converts string into C++-style string pointer.
@@ -283,7 +299,8 @@ struct _NULL_VALUE {
   explicit operator T() const {
     return (T)0;
   }
-} NULL_VALUE;
+};
+inline _NULL_VALUE NULL_VALUE;
 
 template <>
 inline _NULL_VALUE::operator const std::string() const {
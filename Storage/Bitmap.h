@@ -0,0 +1,518 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Compressed bitmap of non-negative integers.
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file multiple times.
+#ifndef BITMAP_H
+#define BITMAP_H
+
+// Includes.
+#include "../Std.h"
+
+// Defines.
+#define BITMAP_ARRAY_MAX 4096  // Maximum number of values kept as sorted array in a container.
+#define BITMAP_WORDS 1024      // Number of 64-bit words of the bitset container (65536 bits).
+
+/**
+ * Values of the bitmap sharing the same upper 16 bits.
+ *
+ * Lower 16 bits of the values are kept either as a sorted array (sparse containers) or as a bitset of 65536 bits
+ * (dense containers), whichever is smaller.
+ */
+struct BitmapContainer {
+  // Upper 16 bits of the values.
+  int key;
+  // Number of values.
+  int cardinality;
+  // Sorted lower 16 bits of the values, unless container is a bitset.
+  ARRAY(unsigned short, values);
+  // Bitset of lower 16 bits of the values, if container is a bitset.
+  ARRAY(unsigned long, words);
+
+  /**
+   * Struct constructor.
+   */
+  BitmapContainer(int _key = 0) : key(_key), cardinality(0) {}
+
+  /**
+   * Returns number of set bits.
+   */
+  static int PopCount(unsigned long _word) {
+    _word = _word - ((_word >> 1) & 0x5555555555555555);
+    _word = (_word & 0x3333333333333333) + ((_word >> 2) & 0x3333333333333333);
+    _word = (_word + (_word >> 4)) & 0x0f0f0f0f0f0f0f0f;
+    return (int)((_word * 0x0101010101010101) >> 56);
+  }
+
+  /* Getters */
+
+  /**
+   * Checks whether container is a bitset.
+   */
+  bool IsBitset() const { return ArraySize(words) > 0; }
+
+  /**
+   * Returns position of the first value not less than the given one in the sorted array.
+   */
+  int LowerBound(int _low) const {
+    int _lo = 0, _hi = cardinality;
+    while (_lo < _hi) {
+      int _mid = (_lo + _hi) / 2;
+      if (values[_mid] < _low) {
+        _lo = _mid + 1;
+      } else {
+        _hi = _mid;
+      }
+    }
+    return _lo;
+  }
+
+  /**
+   * Checks whether container has the given lower 16 bits.
+   */
+  bool Contains(int _low) const {
+    if (IsBitset()) {
+      return (words[_low >> 6] & ((unsigned long)1 << (_low & 63))) != 0;
+    }
+    int _pos = LowerBound(_low);
+    return _pos < cardinality && values[_pos] == _low;
+  }
+
+  /* Modifiers */
+
+  /**
+   * Clears the container.
+   */
+  void Clear(int _key) {
+    key = _key;
+    cardinality = 0;
+    ArrayResize(values, 0);
+    ArrayResize(words, 0);
+  }
+
+  /**
+   * Adds lower 16 bits of the value.
+   *
+   * @return
+   *   Returns false if value was already there.
+   */
+  bool Add(int _low) {
+    if (IsBitset()) {
+      unsigned long _mask = (unsigned long)1 << (_low & 63);
+      if ((words[_low >> 6] & _mask) != 0) {
+        return false;
+      }
+      words[_low >> 6] |= _mask;
+      ++cardinality;
+      return true;
+    }
+    int _pos = cardinality;
+    if (cardinality > 0 && values[cardinality - 1] >= _low) {
+      // Out-of-order value.
+      _pos = LowerBound(_low);
+      if (values[_pos] == _low) {
+        return false;
+      }
+    }
+    ArrayResize(values, cardinality + 1, 64);
+    for (int i = cardinality; i > _pos; --i) {
+      values[i] = values[i - 1];
+    }
+    values[_pos] = (unsigned short)_low;
+    ++cardinality;
+    Normalize();
+    return true;
+  }
+
+  /**
+   * Appends lower 16 bits of the value which are greater than all the others. Used while building sorted arrays.
+   */
+  void Append(int _low) {
+    ArrayResize(values, cardinality + 1, 64);
+    values[cardinality++] = (unsigned short)_low;
+  }
+
+  /**
+   * Converts container into the smaller representation for its cardinality.
+   */
+  void Normalize() {
+    int i;
+    if (IsBitset() && cardinality <= BITMAP_ARRAY_MAX) {
+      ArrayResize(values, cardinality);
+      int _count = 0;
+      for (i = 0; i < BITMAP_WORDS; ++i) {
+        for (unsigned long _word = words[i]; _word != 0; _word &= _word - 1) {
+          values[_count++] = (unsigned short)(i * 64 + PopCount((_word & (0 - _word)) - 1));
+        }
+      }
+      ArrayResize(words, 0);
+    } else if (!IsBitset() && cardinality > BITMAP_ARRAY_MAX) {
+      ArrayResize(words, BITMAP_WORDS);
+      ArrayInitialize(words, 0);
+      for (i = 0; i < cardinality; ++i) {
+        words[values[i] >> 6] |= (unsigned long)1 << (values[i] & 63);
+      }
+      ArrayResize(values, 0);
+    }
+  }
+
+  /**
+   * Recounts cardinality of the bitset.
+   */
+  void Recount() {
+    cardinality = 0;
+    for (int i = 0; i < BITMAP_WORDS; ++i) {
+      cardinality += PopCount(words[i]);
+    }
+  }
+};
+
+/**
+ * Compressed bitmap (Roaring-like) of non-negative integers, e.g. positions of bars.
+ *
+ * Values are split into containers by their upper 16 bits, kept sorted by the key. Each container holds lower 16 bits
+ * of its values either as a sorted array or as a bitset (see BitmapContainer), so both sparse and dense sets take
+ * little memory, and set operations are done container by container, word by word for the dense ones.
+ *
+ * Adding values in the ascending order (e.g., positions of the new bars) only appends to the last container.
+ */
+class Bitmap {
+ protected:
+  // Containers sorted by their keys.
+  ARRAY(BitmapContainer, containers);
+
+  /* Protected methods */
+
+  /**
+   * Returns index of the container with the given key or -1 if there's none.
+   */
+  int FindContainer(int _key) const {
+    int _lo = 0, _hi = ArraySize(containers);
+    while (_lo < _hi) {
+      int _mid = (_lo + _hi) / 2;
+      if (containers[_mid].key < _key) {
+        _lo = _mid + 1;
+      } else {
+        _hi = _mid;
+      }
+    }
+    return _lo < ArraySize(containers) && containers[_lo].key == _key ? _lo : -1;
+  }
+
+  /**
+   * Appends container with the greatest key.
+   */
+  void Push(const BitmapContainer& _container) {
+    int _size = ArraySize(containers);
+    ArrayResize(containers, _size + 1, 16);
+    containers[_size] = _container;
+  }
+
+  /**
+   * Calculates intersection (or difference when _keep is false) of sorted array container with another container.
+   */
+  static void Filter(const BitmapContainer& _a, const BitmapContainer& _b, bool _keep, BitmapContainer& _out) {
+    _out.Clear(_a.key);
+    for (int i = 0; i < _a.cardinality; ++i) {
+      if (_b.Contains(_a.values[i]) == _keep) {
+        _out.Append(_a.values[i]);
+      }
+    }
+  }
+
+  /**
+   * Calculates intersection of containers with the same key.
+   */
+  static void And(const BitmapContainer& _a, const BitmapContainer& _b, BitmapContainer& _out) {
+    if (!_a.IsBitset()) {
+      Filter(_a, _b, true, _out);
+    } else if (!_b.IsBitset()) {
+      Filter(_b, _a, true, _out);
+    } else {
+      _out.Clear(_a.key);
+      ArrayResize(_out.words, BITMAP_WORDS);
+      for (int i = 0; i < BITMAP_WORDS; ++i) {
+        _out.words[i] = _a.words[i] & _b.words[i];
+      }
+      _out.Recount();
+      _out.Normalize();
+    }
+  }
+
+  /**
+   * Calculates union of containers with the same key.
+   */
+  static void Or(const BitmapContainer& _a, const BitmapContainer& _b, BitmapContainer& _out) {
+    int i;
+    _out.Clear(_a.key);
+    if (!_a.IsBitset() && !_b.IsBitset()) {
+      // Merge of sorted arrays.
+      int _i = 0, _j = 0;
+      while (_i < _a.cardinality || _j < _b.cardinality) {
+        if (_j >= _b.cardinality || (_i < _a.cardinality && _a.values[_i] < _b.values[_j])) {
+          _out.Append(_a.values[_i++]);
+        } else if (_i >= _a.cardinality || _b.values[_j] < _a.values[_i]) {
+          _out.Append(_b.values[_j++]);
+        } else {
+          _out.Append(_a.values[_i++]);
+          ++_j;
+        }
+      }
+      _out.Normalize();
+      return;
+    }
+    ArrayResize(_out.words, BITMAP_WORDS);
+    ArrayInitialize(_out.words, 0);
+    if (_a.IsBitset()) {
+      for (i = 0; i < BITMAP_WORDS; ++i) {
+        _out.words[i] = _a.words[i];
+      }
+    } else {
+      for (i = 0; i < _a.cardinality; ++i) {
+        _out.words[_a.values[i] >> 6] |= (unsigned long)1 << (_a.values[i] & 63);
+      }
+    }
+    if (_b.IsBitset()) {
+      for (i = 0; i < BITMAP_WORDS; ++i) {
+        _out.words[i] |= _b.words[i];
+      }
+    } else {
+      for (i = 0; i < _b.cardinality; ++i) {
+        _out.words[_b.values[i] >> 6] |= (unsigned long)1 << (_b.values[i] & 63);
+      }
+    }
+    _out.Recount();
+  }
+
+  /**
+   * Calculates difference of containers with the same key.
+   */
+  static void AndNot(const BitmapContainer& _a, const BitmapContainer& _b, BitmapContainer& _out) {
+    int i;
+    if (!_a.IsBitset()) {
+      Filter(_a, _b, false, _out);
+      return;
+    }
+    _out.Clear(_a.key);
+    ArrayResize(_out.words, BITMAP_WORDS);
+    for (i = 0; i < BITMAP_WORDS; ++i) {
+      _out.words[i] = _a.words[i];
+    }
+    if (_b.IsBitset()) {
+      for (i = 0; i < BITMAP_WORDS; ++i) {
+        _out.words[i] &= ~_b.words[i];
+      }
+    } else {
+      for (i = 0; i < _b.cardinality; ++i) {
+        _out.words[_b.values[i] >> 6] &= ~((unsigned long)1 << (_b.values[i] & 63));
+      }
+    }
+    _out.Recount();
+    _out.Normalize();
+  }
+
+ public:
+  /* Getters */
+
+  /**
+   * Checks whether bitmap has the given value.
+   */
+  bool Contains(int _value) const {
+    int _index = FindContainer(_value >> 16);
+    return _index != -1 && containers[_index].Contains(_value & 0xFFFF);
+  }
+
+  /**
+   * Returns number of values.
+   */
+  int Cardinality() const {
+    int _result = 0;
+    for (int i = 0; i < ArraySize(containers); ++i) {
+      _result += containers[i].cardinality;
+    }
+    return _result;
+  }
+
+  /**
+   * Returns number of containers.
+   */
+  int GetContainersCount() const { return ArraySize(containers); }
+
+  /**
+   * Returns approximate memory taken by the values, in bytes.
+   */
+  int GetSizeInBytes() const {
+    int _result = 0;
+    for (int i = 0; i < ArraySize(containers); ++i) {
+      _result += containers[i].IsBitset() ? BITMAP_WORDS * 8 : containers[i].cardinality * 2;
+    }
+    return _result;
+  }
+
+  /**
+   * Copies values into the array, in the ascending order.
+   *
+   * @return
+   *   Returns number of values.
+   */
+  int ToArray(ARRAY_REF(int, _out)) const {
+    int _count = 0;
+    ArrayResize(_out, Cardinality());
+    for (int c = 0; c < ArraySize(containers); ++c) {
+      int _high = containers[c].key << 16;
+      if (!containers[c].IsBitset()) {
+        for (int i = 0; i < containers[c].cardinality; ++i) {
+          _out[_count++] = _high | containers[c].values[i];
+        }
+        continue;
+      }
+      for (int i = 0; i < BITMAP_WORDS; ++i) {
+        for (unsigned long _word = containers[c].words[i]; _word != 0; _word &= _word - 1) {
+          _out[_count++] = _high | (i * 64 + BitmapContainer::PopCount((_word & (0 - _word)) - 1));
+        }
+      }
+    }
+    return _count;
+  }
+
+  /* Modifiers */
+
+  /**
+   * Adds non-negative value.
+   *
+   * @return
+   *   Returns false if value was already there.
+   */
+  bool Add(int _value) {
+    int _key = _value >> 16;
+    int _size = ArraySize(containers);
+    int _index = _size > 0 && containers[_size - 1].key == _key ? _size - 1 : FindContainer(_key);
+    if (_index == -1) {
+      // Containers are kept sorted by their keys.
+      _index = 0;
+      while (_index < _size && containers[_index].key < _key) {
+        ++_index;
+      }
+      ArrayResize(containers, _size + 1, 16);
+      for (int i = _size; i > _index; --i) {
+        containers[i] = containers[i - 1];
+      }
+      containers[_index].Clear(_key);
+    }
+    return containers[_index].Add(_value & 0xFFFF);
+  }
+
+  /**
+   * Removes all the values.
+   */
+  void Clear() { ArrayResize(containers, 0); }
+
+  /**
+   * Copies values of another bitmap.
+   */
+  void Copy(const Bitmap& _bitmap) {
+    int _size = ArraySize(_bitmap.containers);
+    ArrayResize(containers, _size);
+    for (int i = 0; i < _size; ++i) {
+      containers[i] = _bitmap.containers[i];
+    }
+  }
+
+  /* Operations */
+
+  /**
+   * Calculates intersection of bitmaps. Output may be one of the inputs.
+   */
+  static void And(const Bitmap& _a, const Bitmap& _b, Bitmap& _out) {
+    Bitmap _result;
+    BitmapContainer _container;
+    int _i = 0, _j = 0;
+    while (_i < ArraySize(_a.containers) && _j < ArraySize(_b.containers)) {
+      if (_a.containers[_i].key < _b.containers[_j].key) {
+        ++_i;
+      } else if (_b.containers[_j].key < _a.containers[_i].key) {
+        ++_j;
+      } else {
+        And(_a.containers[_i++], _b.containers[_j++], _container);
+        if (_container.cardinality > 0) {
+          _result.Push(_container);
+        }
+      }
+    }
+    _out.Copy(_result);
+  }
+
+  /**
+   * Calculates union of bitmaps. Output may be one of the inputs.
+   */
+  static void Or(const Bitmap& _a, const Bitmap& _b, Bitmap& _out) {
+    Bitmap _result;
+    BitmapContainer _container;
+    int _i = 0, _j = 0;
+    while (_i < ArraySize(_a.containers) || _j < ArraySize(_b.containers)) {
+      if (_j >= ArraySize(_b.containers) ||
+          (_i < ArraySize(_a.containers) && _a.containers[_i].key < _b.containers[_j].key)) {
+        _result.Push(_a.containers[_i++]);
+      } else if (_i >= ArraySize(_a.containers) || _b.containers[_j].key < _a.containers[_i].key) {
+        _result.Push(_b.containers[_j++]);
+      } else {
+        Or(_a.containers[_i++], _b.containers[_j++], _container);
+        _result.Push(_container);
+      }
+    }
+    _out.Copy(_result);
+  }
+
+  /**
+   * Calculates difference of bitmaps (values of the first one which aren't in the second one). Output may be one of
+   * the inputs.
+   */
+  static void AndNot(const Bitmap& _a, const Bitmap& _b, Bitmap& _out) {
+    Bitmap _result;
+    BitmapContainer _container;
+    for (int _i = 0, _j = 0; _i < ArraySize(_a.containers); ++_i) {
+      while (_j < ArraySize(_b.containers) && _b.containers[_j].key < _a.containers[_i].key) {
+        ++_j;
+      }
+      if (_j < ArraySize(_b.containers) && _b.containers[_j].key == _a.containers[_i].key) {
+        AndNot(_a.containers[_i], _b.containers[_j], _container);
+        if (_container.cardinality > 0) {
+          _result.Push(_container);
+        }
+      } else {
+        _result.Push(_a.containers[_i]);
+      }
+    }
+    _out.Copy(_result);
+  }
+};
+
+#endif  // BITMAP_H
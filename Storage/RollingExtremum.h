@@ -0,0 +1,233 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Streaming highest/lowest value over a sliding window.
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file multiple times.
+#ifndef ROLLING_EXTREMUM_H
+#define ROLLING_EXTREMUM_H
+
+// Includes.
+#include "../Refs.mqh"
+#include "ValueStorage.h"
+
+/**
+ * Highest or lowest value over a sliding window of the given period.
+ *
+ * Uses monotonic deque of (index, value) pairs kept in a ring of period size. Every pushed value drops the values it
+ * makes obsolete from the back, while indices falling out of the window are dropped from the front, so each bar costs
+ * amortised O(1) no matter how long the period is. On equal values the most recent index wins.
+ */
+template <typename C>
+class RollingExtremum : public Dynamic {
+ protected:
+  ARRAY(int, indices);
+  ARRAY(C, values);
+  // Physical position of the front (current extremum) of the deque.
+  int head;
+  // Number of entries in the deque.
+  int count;
+  // Window size.
+  int period;
+  // Whether we track the highest or the lowest value.
+  ENUM_IPEAK type;
+  // Last pushed index or -1 if none.
+  int last;
+  // Key of the last pushed value (e.g., bar time), see Seek().
+  long last_key;
+
+  /* Protected methods */
+
+  /**
+   * Converts logical position in the deque into the physical position in the ring.
+   */
+  int Pos(int _index) {
+    int _pos = head + _index;
+    return _pos >= period ? _pos - period : _pos;
+  }
+
+  /**
+   * Checks whether value _a makes older value _b obsolete.
+   */
+  bool Dominates(C _a, C _b) { return type == IPEAK_HIGHEST ? _a >= _b : _a <= _b; }
+
+  /**
+   * Drops entries which are out of the window ending at the given index.
+   */
+  void Expire(int _index) {
+    while (count > 0 && indices[head] <= _index - period) {
+      head = Pos(1);
+      --count;
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  RollingExtremum(int _period = 1, ENUM_IPEAK _type = IPEAK_HIGHEST) : period(0), type(_type) {
+    SetPeriod(_period, _type);
+  }
+
+  /* Getters */
+
+  /**
+   * Returns window size.
+   */
+  int GetPeriod() { return period; }
+
+  /**
+   * Returns last pushed index or -1 if none.
+   */
+  int GetLastIndex() { return last; }
+
+  /**
+   * Returns key of the last pushed value.
+   */
+  long GetLastKey() { return last_key; }
+
+  /* Setters */
+
+  /**
+   * Sets window size and type of the extremum. Resets the state if any of them has changed.
+   */
+  void SetPeriod(int _period, ENUM_IPEAK _type) {
+    _period = MathMax(_period, 1);
+    if (_period == period && _type == type) {
+      return;
+    }
+    period = _period;
+    type = _type;
+    ArrayResize(indices, period);
+    ArrayResize(values, period);
+    Reset();
+  }
+
+  /* Modifiers */
+
+  /**
+   * Clears the window.
+   */
+  void Reset() {
+    head = 0;
+    count = 0;
+    last = -1;
+    last_key = 0;
+  }
+
+  /**
+   * Pushes value of the given index into the window. Indices are expected to increase.
+   */
+  void Push(int _index, C _value) {
+    Expire(_index);
+    while (count > 0 && Dominates(_value, values[Pos(count - 1)])) {
+      --count;
+    }
+    int _pos = Pos(count);
+    indices[_pos] = _index;
+    values[_pos] = _value;
+    ++count;
+    last = _index;
+  }
+
+  /**
+   * Pushes value with the given key next to the last pushed one.
+   */
+  void Append(C _value, long _key) {
+    Push(last + 1, _value);
+    last_key = _key;
+  }
+
+  /**
+   * Moves window keyed by bar times (see Append()) to end at the given bar, before its value is peeked.
+   *
+   * Takes times of the two bars preceding the given one. Window ending at the previous bar needs nothing, while new bar
+   * needs the previously peeked bar to be pushed. Otherwise window is cleared and has to be refilled.
+   *
+   * @return
+   *   Returns number of the bars preceding the given one to append (the oldest first).
+   */
+  int Seek(long _prev_time, long _prev2_time) {
+    if (last >= 0 && last_key == _prev_time) {
+      return 0;
+    }
+    if (last >= 0 && last_key == _prev2_time) {
+      return 1;
+    }
+    Reset();
+    return period - 1;
+  }
+
+  /**
+   * Returns how many bars before the given one the extremum is, after Seek() and Append() calls. See PeekIndex().
+   */
+  int PeekShift(C _value) { return last + 1 - PeekIndex(last + 1, _value); }
+
+  /**
+   * Returns extremum of the window ending at the given index, as if value of that index would be pushed.
+   *
+   * Pushes nothing, so it may be called repeatedly for the last bar while its value is still changing.
+   */
+  C Peek(int _index, C _value) {
+    Expire(_index);
+    return count == 0 || Dominates(_value, values[head]) ? _value : values[head];
+  }
+
+  /**
+   * Returns index of the extremum of the window ending at the given index. See Peek().
+   */
+  int PeekIndex(int _index, C _value) {
+    Expire(_index);
+    return count == 0 || Dominates(_value, values[head]) ? _index : indices[head];
+  }
+
+  /**
+   * Returns extremum of the window ending at the given index of the series.
+   *
+   * Meant to be called for consecutive indices. Value of the given index is only peeked and gets pushed on the call
+   * for the next index, so recalculating the last (still forming) bar is O(1) too. Any other access pattern
+   * rebuilds the window from the series in O(period).
+   */
+  C Update(ValueStorage<C> &_series, int _index) {
+    if (last != _index - 1) {
+      if (last == _index - 2) {
+        Push(_index - 1, _series.Fetch(_index - 1));
+      } else {
+        Reset();
+        for (int i = MathMax(0, _index - period + 1); i < _index; ++i) {
+          Push(i, _series.Fetch(i));
+        }
+      }
+    }
+    return Peek(_index, _series.Fetch(_index));
+  }
+};
+
+#endif  // ROLLING_EXTREMUM_H
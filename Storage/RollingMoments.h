@@ -0,0 +1,202 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Streaming mean and standard deviation over a sliding window.
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file multiple times.
+#ifndef ROLLING_MOMENTS_H
+#define ROLLING_MOMENTS_H
+
+// Includes.
+#include "../Refs.mqh"
+#include "ValueStorage.h"
+
+// Defines.
+#define ROLLING_MOMENTS_REBUILD 4096  // Minimum number of commits after which moments are recalculated from scratch.
+
+/**
+ * Mean and population variance over a sliding window of the given period.
+ *
+ * Keeps mean and sum of squared deviations of the window updated by Welford's method, so each bar costs O(1) no
+ * matter how long the period is. The moments are re-anchored (recalculated from the series) every
+ * max(period, ROLLING_MOMENTS_REBUILD) bars, so the rounding errors can't accumulate over long histories.
+ */
+template <typename C>
+class RollingMoments : public Dynamic {
+ protected:
+  // Number of values, mean and sum of squared deviations of the committed window.
+  int count;
+  double mean;
+  double m2;
+  // Number of values, mean and sum of squared deviations of the last updated window.
+  int peek_count;
+  double peek_mean;
+  double peek_m2;
+  // Window size.
+  int period;
+  // Last committed index or -1 if none.
+  int last;
+  // Number of commits since the last rebuild.
+  int commits;
+
+  /* Protected methods */
+
+  /**
+   * Recalculates moments of the window ending at the index preceding the given one.
+   */
+  void Rebuild(ValueStorage<C> &_series, int _index) {
+    int _from = MathMax(0, _index - period);
+    int i;
+    count = _index - _from;
+    mean = 0;
+    m2 = 0;
+    for (i = _from; i < _index; ++i) {
+      mean += (double)_series.Fetch(i);
+    }
+    mean = count > 0 ? mean / count : 0;
+    for (i = _from; i < _index; ++i) {
+      double _delta = (double)_series.Fetch(i) - mean;
+      m2 += _delta * _delta;
+    }
+    last = _index - 1;
+    commits = 0;
+  }
+
+  /**
+   * Calculates moments of the window after adding the given value and removing the oldest one (if window is full).
+   */
+  void Slide(int _count, double _mean, double _m2, double _value, double _oldest, bool _remove, int &_out_count,
+             double &_out_mean, double &_out_m2) {
+    double _delta;
+    if (_remove) {
+      // Replacing the oldest value keeps number of values.
+      _delta = _value - _oldest;
+      _out_count = _count;
+      _out_mean = _mean + _delta / _count;
+      _out_m2 = _m2 + _delta * (_value - _out_mean + _oldest - _mean);
+    } else {
+      _delta = _value - _mean;
+      _out_count = _count + 1;
+      _out_mean = _mean + _delta / _out_count;
+      _out_m2 = _m2 + _delta * (_value - _out_mean);
+    }
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  RollingMoments(int _period = 1) : period(0) { SetPeriod(_period); }
+
+  /* Getters */
+
+  /**
+   * Returns window size.
+   */
+  int GetPeriod() { return period; }
+
+  /**
+   * Returns number of values in the last updated window.
+   */
+  int GetCount() { return peek_count; }
+
+  /**
+   * Returns mean of the last updated window.
+   */
+  double GetMean() { return peek_mean; }
+
+  /**
+   * Returns population variance of the last updated window.
+   */
+  double GetVariance() { return peek_count > 0 ? MathMax(0.0, peek_m2 / peek_count) : 0; }
+
+  /**
+   * Returns population standard deviation of the last updated window.
+   */
+  double GetStdDev() { return MathSqrt(GetVariance()); }
+
+  /* Setters */
+
+  /**
+   * Sets window size. Resets the state if it has changed.
+   */
+  void SetPeriod(int _period) {
+    _period = MathMax(_period, 1);
+    if (_period == period) {
+      return;
+    }
+    period = _period;
+    Reset();
+  }
+
+  /* Modifiers */
+
+  /**
+   * Clears the window.
+   */
+  void Reset() {
+    count = 0;
+    mean = 0;
+    m2 = 0;
+    peek_count = 0;
+    peek_mean = 0;
+    peek_m2 = 0;
+    last = -1;
+    commits = 0;
+  }
+
+  /**
+   * Updates moments to the window ending at the given index of the series.
+   *
+   * Meant to be called for consecutive indices. Value of the given index is only peeked and gets committed on the
+   * call for the next index, so recalculating the last (still forming) bar is O(1) too. Any other access pattern
+   * rebuilds the moments from the series in O(period).
+   */
+  void Update(ValueStorage<C> &_series, int _index) {
+    bool _remove;
+    if (last != _index - 1) {
+      if (last == _index - 2 && commits < MathMax(period, ROLLING_MOMENTS_REBUILD)) {
+        _remove = _index - 1 - period >= 0;
+        Slide(count, mean, m2, (double)_series.Fetch(_index - 1),
+              _remove ? (double)_series.Fetch(_index - 1 - period) : 0, _remove, count, mean, m2);
+        last = _index - 1;
+        ++commits;
+      } else {
+        Rebuild(_series, _index);
+      }
+    }
+
+    _remove = _index - period >= 0;
+    Slide(count, mean, m2, (double)_series.Fetch(_index), _remove ? (double)_series.Fetch(_index - period) : 0,
+          _remove, peek_count, peek_mean, peek_m2);
+  }
+};
+
+#endif  // ROLLING_MOMENTS_H
@@ -0,0 +1,320 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Streaming median and percentiles over a sliding window.
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file multiple times.
+#ifndef ROLLING_PERCENTILE_H
+#define ROLLING_PERCENTILE_H
+
+// Includes.
+#include "../Refs.mqh"
+#include "ValueStorage.h"
+
+/**
+ * Percentile (median by default) over a sliding window of the given period.
+ *
+ * Window values are split between two indexed binary heaps: a max-heap with the lower part of the window and a
+ * min-heap with the upper part, sized so the top of the lower heap is the value at the percentile's rank. Every value
+ * keeps its slot in a ring of period size, and heaps remember position of each slot, so evicting the oldest value or
+ * replacing the newest one is a direct O(log n) heap removal instead of sorting the whole window.
+ *
+ * Percentile is interpolated linearly between the closest ranks, so median of an even window is the average of the
+ * two middle values, as in IndicatorData::GetMed() and Buffer::GetMed().
+ */
+template <typename C>
+class RollingPercentile : public Dynamic {
+ protected:
+  // Window values kept by slot (ring position).
+  ARRAY(C, values);
+  // Heap (0 - lower/max-heap, 1 - upper/min-heap) and position within that heap of each slot.
+  ARRAY(int, sides);
+  ARRAY(int, positions);
+  // Slots of the lower and upper heaps.
+  ARRAY(int, lower);
+  ARRAY(int, upper);
+  int lower_count;
+  int upper_count;
+  // Slot of the oldest value.
+  int head;
+  // Number of values in the window.
+  int count;
+  // Window size.
+  int period;
+  // Percentile in range [0, 1].
+  double percentile;
+  // Key (e.g., index or bar time) of the newest value or -1 if none.
+  long last;
+
+  /* Protected methods */
+
+  /**
+   * Returns slot at the given position of the heap.
+   */
+  int HeapGet(int _side, int _pos) { return _side == 0 ? lower[_pos] : upper[_pos]; }
+
+  /**
+   * Puts slot at the given position of the heap.
+   */
+  void HeapSet(int _side, int _pos, int _slot) {
+    if (_side == 0) {
+      lower[_pos] = _slot;
+    } else {
+      upper[_pos] = _slot;
+    }
+    sides[_slot] = _side;
+    positions[_slot] = _pos;
+  }
+
+  /**
+   * Checks whether slot _a should be closer to the top of the heap than slot _b.
+   */
+  bool Above(int _side, int _a, int _b) { return _side == 0 ? values[_a] > values[_b] : values[_a] < values[_b]; }
+
+  /**
+   * Moves slot at the given position up the heap as long as needed.
+   */
+  void SiftUp(int _side, int _pos) {
+    int _slot = HeapGet(_side, _pos);
+    while (_pos > 0) {
+      int _parent = (_pos - 1) >> 1;
+      int _parent_slot = HeapGet(_side, _parent);
+      if (!Above(_side, _slot, _parent_slot)) {
+        break;
+      }
+      HeapSet(_side, _pos, _parent_slot);
+      _pos = _parent;
+    }
+    HeapSet(_side, _pos, _slot);
+  }
+
+  /**
+   * Moves slot at the given position down the heap as long as needed.
+   */
+  void SiftDown(int _side, int _pos) {
+    int _size = _side == 0 ? lower_count : upper_count;
+    int _slot = HeapGet(_side, _pos);
+    while (true) {
+      int _child = 2 * _pos + 1;
+      if (_child >= _size) {
+        break;
+      }
+      if (_child + 1 < _size && Above(_side, HeapGet(_side, _child + 1), HeapGet(_side, _child))) {
+        ++_child;
+      }
+      int _child_slot = HeapGet(_side, _child);
+      if (!Above(_side, _child_slot, _slot)) {
+        break;
+      }
+      HeapSet(_side, _pos, _child_slot);
+      _pos = _child;
+    }
+    HeapSet(_side, _pos, _slot);
+  }
+
+  /**
+   * Adds slot to the heap.
+   */
+  void HeapPush(int _side, int _slot) {
+    int _pos = _side == 0 ? lower_count++ : upper_count++;
+    HeapSet(_side, _pos, _slot);
+    SiftUp(_side, _pos);
+  }
+
+  /**
+   * Removes slot from the heap it is in.
+   */
+  void HeapRemove(int _slot) {
+    int _side = sides[_slot];
+    int _pos = positions[_slot];
+    int _last = _side == 0 ? --lower_count : --upper_count;
+    if (_pos == _last) {
+      return;
+    }
+    // Moving the last slot of the heap into the gap, then restoring the heap order in either direction.
+    int _moved = HeapGet(_side, _last);
+    HeapSet(_side, _pos, _moved);
+    SiftUp(_side, _pos);
+    SiftDown(_side, positions[_moved]);
+  }
+
+  /**
+   * Returns rank (0-based position in the sorted window) of the lower value used by the percentile.
+   */
+  int GetRank() { return count > 0 ? (int)(percentile * (count - 1)) : 0; }
+
+  /**
+   * Moves values between the heaps, so the lower heap holds exactly the values up to the percentile's rank.
+   */
+  void Balance() {
+    int _target = count > 0 ? GetRank() + 1 : 0;
+    while (lower_count > _target) {
+      int _slot = lower[0];
+      HeapRemove(_slot);
+      HeapPush(1, _slot);
+    }
+    while (lower_count < _target) {
+      int _slot = upper[0];
+      HeapRemove(_slot);
+      HeapPush(0, _slot);
+    }
+  }
+
+  /**
+   * Puts value into the given slot and into the heap it belongs to.
+   */
+  void Insert(int _slot, C _value) {
+    values[_slot] = _value;
+    HeapPush(lower_count > 0 && _value <= values[lower[0]] ? 0 : 1, _slot);
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  RollingPercentile(int _period = 1, double _percentile = 0.5) : period(0), percentile(-1) {
+    SetPeriod(_period, _percentile);
+  }
+
+  /* Getters */
+
+  /**
+   * Returns window size.
+   */
+  int GetPeriod() { return period; }
+
+  /**
+   * Returns percentile in range [0, 1].
+   */
+  double GetPercentile() { return percentile; }
+
+  /**
+   * Returns number of values in the window.
+   */
+  int GetCount() { return count; }
+
+  /**
+   * Returns key of the newest value or -1 if none.
+   */
+  long GetLastKey() { return last; }
+
+  /**
+   * Returns percentile of the values in the window or 0 if window is empty.
+   */
+  double Get() {
+    if (count == 0) {
+      return 0;
+    }
+    double _lo = (double)values[lower[0]];
+    double _frac = percentile * (count - 1) - GetRank();
+    return _frac > 0 && upper_count > 0 ? _lo + _frac * ((double)values[upper[0]] - _lo) : _lo;
+  }
+
+  /* Setters */
+
+  /**
+   * Sets window size and percentile (in range [0, 1], 0.5 for median). Resets the state if any of them has changed.
+   */
+  void SetPeriod(int _period, double _percentile = 0.5) {
+    _period = MathMax(_period, 1);
+    _percentile = MathMax(0.0, MathMin(1.0, _percentile));
+    if (_period == period && _percentile == percentile) {
+      return;
+    }
+    period = _period;
+    percentile = _percentile;
+    ArrayResize(values, period);
+    ArrayResize(sides, period);
+    ArrayResize(positions, period);
+    ArrayResize(lower, period);
+    ArrayResize(upper, period);
+    Reset();
+  }
+
+  /* Modifiers */
+
+  /**
+   * Clears the window.
+   */
+  void Reset() {
+    lower_count = 0;
+    upper_count = 0;
+    head = 0;
+    count = 0;
+    last = -1;
+  }
+
+  /**
+   * Adds value with the given key into the window, evicting the oldest value when the window is full.
+   *
+   * Value with the same key as the newest one replaces it instead, so the last (still forming) bar may be updated
+   * repeatedly. Keys are expected to increase.
+   */
+  void Add(long _key, C _value) {
+    int _slot;
+    if (count > 0 && _key == last) {
+      // Replacing the newest value.
+      _slot = head + count - 1;
+      _slot = _slot >= period ? _slot - period : _slot;
+      HeapRemove(_slot);
+    } else if (count == period) {
+      // Evicting the oldest value, its slot is reused for the new one.
+      _slot = head;
+      HeapRemove(_slot);
+      head = head + 1 >= period ? 0 : head + 1;
+    } else {
+      _slot = head + count;
+      _slot = _slot >= period ? _slot - period : _slot;
+      ++count;
+    }
+    Insert(_slot, _value);
+    Balance();
+    last = _key;
+  }
+
+  /**
+   * Returns percentile of the window ending at the given index of the series.
+   *
+   * Meant to be called for consecutive indices, each one possibly multiple times while its value is still changing.
+   * Any other access pattern rebuilds the window from the series in O(period log period).
+   */
+  double Update(ValueStorage<C> &_series, int _index) {
+    if (count == 0 || (_index != last && _index != last + 1)) {
+      Reset();
+      for (int i = MathMax(0, _index - period + 1); i < _index; ++i) {
+        Add(i, _series.Fetch(i));
+      }
+    }
+    Add(_index, _series.Fetch(_index));
+    return Get();
+  }
+};
+
+#endif  // ROLLING_PERCENTILE_H
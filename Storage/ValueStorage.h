@@ -65,12 +65,12 @@ enum ENUM_IPEAK { IPEAK_LOWEST, IPEAK_HIGHEST };
 
 #define INDICATOR_CALCULATE_GET_PARAMS_SHORT _cache.GetTotal(), _cache.GetPrevCalculated(), 0, _cache.GetPriceBuffer()
 
-#define INDICATOR_CALCULATE_POPULATE_CACHE(SYMBOL, TF, KEY)                                              \
-  IndicatorCalculateCache<double> *_cache;                                                               \
-  string _key = Util::MakeKey(SYMBOL, (int)TF, KEY);                                                     \
-  if (!Objects<IndicatorCalculateCache<double>>::TryGet(_key, _cache)) {                                 \
-    _cache = Objects<IndicatorCalculateCache<double>>::Set(_key, new IndicatorCalculateCache<double>()); \
-  }
+// KEY is a typed key of the calculation (see IndicatorParamsKey::Make()), extended by symbol and timeframe.
+#define INDICATOR_CALCULATE_POPULATE_CACHE(SYMBOL, TF, KEY) \
+  IndicatorParamsKey _key = KEY;                            \
+  _key.AddString(SYMBOL);                                   \
+  _key.AddInteger(TF);                                      \
+  IndicatorCalculateCache<double> *_cache = IndicatorCalculateCaches::GetByKey(_key);
 
 #define INDICATOR_CALCULATE_POPULATE_PARAMS_AND_CACHE_LONG(SYMBOL, TF, KEY)                     \
   ValueStorage<datetime> *_time = TimeValueStorage::GetInstance(SYMBOL, TF);                    \
@@ -164,6 +164,29 @@ class ValueStorage : public IValueStorage {
    */
   virtual C FetchSeries(int _shift) { return Fetch(ArraySize(THIS_REF) - _shift - 1); }
 
+  /**
+   * Fetches given number of values starting from a given shift into the target array, resizing it when needed.
+   * Takes into consideration as-series flag.
+   *
+   * Works as a sequence of Fetch() calls. Storages which are able to retrieve the whole range at once should override
+   * it, so kernels could read their input with a single call instead of a virtual call per value.
+   *
+   * @return
+   *   Returns number of values fetched.
+   */
+  virtual int FetchRange(int _start, int _count, ARRAY_REF(C, _out), int _out_start = 0) {
+    if (_count <= 0) {
+      return 0;
+    }
+    if (ArraySize(_out) < _out_start + _count) {
+      ArrayResize(_out, _out_start + _count);
+    }
+    for (int i = 0; i < _count; ++i) {
+      _out[_out_start + i] = Fetch(_start + i);
+    }
+    return _count;
+  }
+
   /**
    * Stores value at a given shift. Takes into consideration as-series flag.
    */
@@ -193,7 +216,7 @@ void ArrayInitialize(ValueStorage<C> &_storage, C _value) {
  * ValueStorage-compatible wrapper for ArrayCopy.
  */
 template <typename C, typename D>
-int ArrayCopy(D &_target[], ValueStorage<C> &_source, int _dst_start = 0, int _src_start = 0, int count = WHOLE_ARRAY) {
+int ArrayCopy(ARRAY_REF(D, _target), ValueStorage<C> &_source, int _dst_start = 0, int _src_start = 0, int count = WHOLE_ARRAY) {
   if (count == WHOLE_ARRAY) {
     count = ArraySize(_source);
   }
@@ -218,24 +241,26 @@ int ArrayCopy(D &_target[], ValueStorage<C> &_source, int _dst_start = 0, int _s
     ArrayResize(_target, _dst_required_size, 32);
   }
 
-  int _num_copied, t, s;
-
-  for (_num_copied = 0, t = _dst_start, s = _src_start; _num_copied < count; ++_num_copied, ++t, ++s) {
-    if (s >= ArraySize(_source)) {
-      // No more data to copy.
-      break;
-    }
+  if (count <= 0) {
+    return 0;
+  }
 
-    bool _reverse = ArrayGetAsSeries(_target) != ArrayGetAsSeries(_source);
+  bool _reverse = ArrayGetAsSeries(_target) != ArrayGetAsSeries(_source);
 
-    int _source_idx = _reverse ? (ArraySize(_source) - s - 1 + _src_start) : s;
+  // Fetching the whole source range at once.
+  ARRAY(C, _values);
+  _source.FetchRange(_reverse ? ArraySize(_source) - count : _src_start, count, _values);
 
-    _target[t] = _source[_source_idx].Get();
+  for (int i = 0; i < count; ++i) {
+    _target[_dst_start + i] = _values[_reverse ? count - 1 - i : i];
   }
 
-  return _num_copied;
+  return count;
 }
 
+// Forward declarations.
+int iPeak(ValueStorage<double> &_price, int _count, int _start, ENUM_IPEAK _type);
+
 /**
  * iHigest() version working on ValueStorage.
  */
@@ -272,8 +297,16 @@ int iPeak(ValueStorage<double> &_price, int _count, int _start, ENUM_IPEAK _type
       break;
   }
 
-  for (int i = _start; (i < _start + _count) && (i < _price_size); ++i) {
-    double _value = _price.FetchSeries(i);
+  int _end = MathMin(_start + _count, _price_size);
+  ARRAY(double, _values);
+
+  if (_end > _start) {
+    // Fetching the whole range at once. Values are fetched in non-series order, so the newest one goes last.
+    _price.FetchRange(_price_size - _end, _end - _start, _values);
+  }
+
+  for (int i = _start; i < _end; ++i) {
+    double _value = _values[_end - 1 - i];
 
     bool _cond = false;
 
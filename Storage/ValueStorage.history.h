@@ -31,6 +31,7 @@
 #endif
 
 // Includes.
+#include "../Chart.history.h"
 #include "ValueStorage.h"
 
 // Forward declarations.
@@ -55,12 +56,15 @@ class HistoryValueStorage : public ValueStorage<C> {
   // Whether storage operates in as-series mode.
   bool is_series;
 
+  // Shared cache of the history.
+  ChartHistory* history;
+
  public:
   /**
    * Constructor.
    */
   HistoryValueStorage(string _symbol, ENUM_TIMEFRAMES _tf, bool _is_series = false)
-      : symbol(_symbol), tf(_tf), is_series(_is_series) {
+      : symbol(_symbol), tf(_tf), is_series(_is_series), history(ChartHistory::GetInstance(_symbol, _tf)) {
     start_bar_time = ChartStatic::iTime(_symbol, _tf, BarsFromStart() - 1);
   }
 
@@ -83,6 +87,30 @@ class HistoryValueStorage : public ValueStorage<C> {
     }
   }
 
+  /**
+   * Returns series shift of the newest bar of the given range of values or -1 if range exceeds the history.
+   */
+  int RangeShift(int _start, int _count) {
+    int _bars = BarsFromStart();
+    if (_start < 0 || _count <= 0 || _start + _count > _bars) {
+      return -1;
+    }
+    return is_series ? _start : _bars - _start - _count;
+  }
+
+  /**
+   * Places values retrieved in chronological order (as Copy*() functions return them) into the target array.
+   */
+  int PlaceRange(ARRAY_REF(C, _src), int _count, ARRAY_REF(C, _out), int _out_start) {
+    if (ArraySize(_out) < _out_start + _count) {
+      ArrayResize(_out, _out_start + _count);
+    }
+    for (int i = 0; i < _count; ++i) {
+      _out[_out_start + i] = _src[is_series ? _count - 1 - i : i];
+    }
+    return _count;
+  }
+
   /**
    * Number of bars passed from the start. There will be a single bar at the start.
    */
@@ -58,4 +58,22 @@ class IndicatorBufferValueStorage : public HistoryValueStorage<C> {
    * Fetches value from a given shift. Takes into consideration as-series flag.
    */
   virtual C Fetch(int _shift) { return indicator.GetValue<C>(mode, RealShift(_shift)); }
+
+  /**
+   * Fetches given number of values starting from a given shift into the target array, resizing it when needed.
+   *
+   * Reads values straight from the indicator, without going through virtual Fetch() for each of them.
+   */
+  virtual int FetchRange(int _start, int _count, ARRAY_REF(C, _out), int _out_start = 0) {
+    if (_count <= 0) {
+      return 0;
+    }
+    if (ArraySize(_out) < _out_start + _count) {
+      ArrayResize(_out, _out_start + _count);
+    }
+    for (int i = 0; i < _count; ++i) {
+      _out[_out_start + i] = indicator.GetValue<C>(mode, RealShift(_start + i));
+    }
+    return _count;
+  }
 };
@@ -69,6 +69,25 @@ class NativeValueStorage : public ValueStorage<C> {
     return _values[_shift];
   }
 
+  /**
+   * Fetches given number of values starting from a given shift into the target array, resizing it when needed.
+   *
+   * Copies the whole range with a single native ArrayCopy() call.
+   */
+  virtual int FetchRange(int _start, int _count, ARRAY_REF(C, _out), int _out_start = 0) {
+    if (IsSeries() || _start < 0 || _start + _count > ArraySize(_values)) {
+      // Out-of-range values are fetched one by one, the same way Fetch() does.
+      return ValueStorage<C>::FetchRange(_start, _count, _out, _out_start);
+    }
+    if (_count <= 0) {
+      return 0;
+    }
+    if (ArraySize(_out) < _out_start + _count) {
+      ArrayResize(_out, _out_start + _count);
+    }
+    return ArrayCopy(_out, _values, _out_start, _start, _count);
+  }
+
   /**
    * Stores value at a given shift. Takes into consideration as-series flag.
    */
@@ -74,13 +74,10 @@ class PriceValueStorage : public HistoryValueStorage<double> {
       case PRICE_HIGH:
       case PRICE_LOW:
       case PRICE_CLOSE:
-        return Fetch(ap, _shift);
       case PRICE_MEDIAN:
-        return (Fetch(PRICE_HIGH, _shift) + Fetch(PRICE_LOW, _shift)) / 2;
       case PRICE_TYPICAL:
-        return (Fetch(PRICE_HIGH, _shift) + Fetch(PRICE_LOW, _shift) + Fetch(PRICE_CLOSE, _shift)) / 3;
       case PRICE_WEIGHTED:
-        return (Fetch(PRICE_HIGH, _shift) + Fetch(PRICE_LOW, _shift) + (2 * Fetch(PRICE_CLOSE, _shift))) / 4;
+        return Fetch(ap, _shift);
       default:
         Print("We shouldn't be here!");
         DebugBreak();
@@ -88,20 +85,29 @@ class PriceValueStorage : public HistoryValueStorage<double> {
     return 0.0;
   }
 
-  double Fetch(ENUM_APPLIED_PRICE _ap, int _shift) {
-    switch (_ap) {
-      case PRICE_OPEN:
-        return iOpen(symbol, tf, RealShift(_shift));
-      case PRICE_HIGH:
-        return iHigh(symbol, tf, RealShift(_shift));
-      case PRICE_LOW:
-        return iLow(symbol, tf, RealShift(_shift));
-      case PRICE_CLOSE:
-        return iClose(symbol, tf, RealShift(_shift));
+  /**
+   * Fetches given number of values starting from a given shift into the target array, resizing it when needed.
+   *
+   * Values are copied from the cached history at once, with applied prices combined from the cached OHLC.
+   */
+  virtual int FetchRange(int _start, int _count, ARRAY_REF(double, _out), int _out_start = 0) {
+    int _shift = RangeShift(_start, _count);
+    ARRAY(double, _result);
+    if (_shift < 0 || !CopyRange(ap, _shift, _count, _result)) {
+      return HistoryValueStorage<double>::FetchRange(_start, _count, _out, _out_start);
     }
-    return 0;
+    return PlaceRange(_result, _count, _out, _out_start);
   }
 
+  /**
+   * Copies given number of applied prices in chronological order, starting from the given series shift.
+   */
+  bool CopyRange(ENUM_APPLIED_PRICE _ap, int _shift, int _count, ARRAY_REF(double, _arr)) {
+    return history PTR_DEREF GetPrices(_ap, _shift, _count, _arr) == _count;
+  }
+
+  double Fetch(ENUM_APPLIED_PRICE _ap, int _shift) { return history PTR_DEREF GetPrice(_ap, RealShift(_shift)); }
+
   static double GetApplied(ValueStorage<double> &_open, ValueStorage<double> &_high, ValueStorage<double> &_low,
                            ValueStorage<double> &_close, int _shift, ENUM_APPLIED_PRICE _ap) {
     switch (_ap) {
@@ -59,5 +59,5 @@ class TickVolumeValueStorage : public HistoryValueStorage<long> {
   /**
    * Fetches value from a given shift. Takes into consideration as-series flag.
    */
-  virtual long Fetch(int _shift) { return ChartStatic::iVolume(symbol, tf, RealShift(_shift)); }
+  virtual long Fetch(int _shift) { return history PTR_DEREF GetTickVolume(RealShift(_shift)); }
 };
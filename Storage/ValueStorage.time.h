@@ -59,5 +59,17 @@ class TimeValueStorage : public HistoryValueStorage<datetime> {
   /**
    * Fetches value from a given shift. Takes into consideration as-series flag.
    */
-  virtual datetime Fetch(int _shift) { return iTime(symbol, tf, RealShift(_shift)); }
+  virtual datetime Fetch(int _shift) { return history PTR_DEREF GetTime(RealShift(_shift)); }
+
+  /**
+   * Fetches given number of values starting from a given shift, copied from the cached history at once.
+   */
+  virtual int FetchRange(int _start, int _count, ARRAY_REF(datetime, _out), int _out_start = 0) {
+    int _shift = RangeShift(_start, _count);
+    ARRAY(datetime, _times);
+    if (_shift < 0 || history PTR_DEREF GetTimes(_shift, _count, _times) != _count) {
+      return HistoryValueStorage<datetime>::FetchRange(_start, _count, _out, _out_start);
+    }
+    return PlaceRange(_times, _count, _out, _out_start);
+  }
 };
@@ -59,12 +59,7 @@ class VolumeValueStorage : public HistoryValueStorage<long> {
    * Fetches value from a given shift. Takes into consideration as-series flag.
    */
   virtual long Fetch(int _shift) {
-    ResetLastError();
-    long _volume = iVolume(symbol, tf, RealShift(_shift));
-    if (_LastError != ERR_NO_ERROR) {
-      Print("Cannot fetch iVolume! Error: ", _LastError);
-      DebugBreak();
-    }
-    return _volume;
+    // Same as iVolume(), which returns tick volume.
+    return history PTR_DEREF GetTickVolume(RealShift(_shift));
   }
 };
@@ -27,6 +27,7 @@
 
 // Define external global functions.
 #ifndef __MQL__
+extern double SymbolInfoDouble(string name, ENUM_SYMBOL_INFO_DOUBLE prop_id);
 extern long SymbolInfoInteger(string name, ENUM_SYMBOL_INFO_INTEGER prop_id);
 extern bool SymbolInfoMarginRate(string name, ENUM_ORDER_TYPE order_type, double &initial_margin_rate,
                                  double &maintenance_margin_rate);
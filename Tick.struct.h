@@ -33,6 +33,14 @@
 #include "DateTime.extern.h"
 
 #ifndef __MQL__
+// Flags of the tick (MqlTick::flags).
+#define TICK_FLAG_BID 2       // Tick has changed a Bid price.
+#define TICK_FLAG_ASK 4       // Tick has changed an Ask price.
+#define TICK_FLAG_LAST 8      // Tick has changed the last deal price.
+#define TICK_FLAG_VOLUME 16   // Tick has changed a volume.
+#define TICK_FLAG_BUY 32      // Tick is a result of a buy deal.
+#define TICK_FLAG_SELL 64     // Tick is a result of a sell deal.
+
 /**
  * Structure for storing the latest prices of the symbol.
  * @docs
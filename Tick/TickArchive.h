@@ -0,0 +1,932 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __MQL__
+// Allows the preprocessor to include a header file when it is needed.
+#pragma once
+#endif
+
+// Prevents processing this includes file for the second time.
+#ifndef TICK_ARCHIVE_H
+#define TICK_ARCHIVE_H
+
+// Includes.
+#include "../Buffer/BufferTick.h"
+#include "../File.define.h"
+#include "../Math.extern.h"
+#include "../SymbolInfo.extern.h"
+#include "../Tick.struct.h"
+
+#ifndef __MQL__
+// Includes for file I/O and memory mapping.
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#endif
+
+// Defines.
+#define TICK_ARCHIVE_MAGIC 0x41544145    // "EATA".
+#define TICK_ARCHIVE_VERSION 2
+#define TICK_ARCHIVE_CHUNK_SIZE 4096     // Default number of ticks per chunk.
+#define TICK_ARCHIVE_HEADER_SIZE 44      // Size of the header without the symbol's name.
+#define TICK_ARCHIVE_INDEX_ENTRY_SIZE 32
+
+// Bytes to decode: array in MQL, pointer into the memory-mapped file in C++.
+#ifdef __MQL__
+#define TICK_ARCHIVE_BYTES(N) const unsigned char &N[]
+#define TICK_ARCHIVE_SOURCE(OFFSET) buffer
+#else
+#define TICK_ARCHIVE_BYTES(N) const unsigned char *N
+#define TICK_ARCHIVE_SOURCE(OFFSET) (data + (OFFSET))
+#endif
+
+/**
+ * Entry of the archive's index, describing a single chunk of ticks.
+ */
+struct TickArchiveChunk {
+  long offset;     // Offset of the chunk in the file.
+  long time_from;  // Time of the first tick in milliseconds.
+  long time_to;    // Time of the last tick in milliseconds.
+  int size;        // Size of the encoded chunk in bytes.
+  int count;       // Number of ticks in the chunk.
+  // Struct constructor.
+  TickArchiveChunk() : offset(0), time_from(0), time_to(0), size(0), count(0) {}
+};
+
+/**
+ * Encodes and decodes chunks of the tick archive.
+ *
+ * Chunk keeps its ticks as columns of times, bids, spreads, last prices, volumes and flags. Prices are stored as
+ * integer points, so only prices rounded to the symbol's digits can be stored (see TickArchiveWriter::Add()). Times,
+ * bids, spreads and last prices are stored as deltas from the previous tick, which are mostly small, so as zigzag
+ * varints they take a byte or two each.
+ */
+class TickArchiveCodec {
+ public:
+  /**
+   * Maps signed value to unsigned one, so values close to zero have short varints.
+   */
+  static unsigned long ZigZag(long _value) { return ((unsigned long)_value << 1) ^ (unsigned long)(_value >> 63); }
+
+  /**
+   * Reverts ZigZag().
+   */
+  static long UnZigZag(unsigned long _value) { return (long)(_value >> 1) ^ -(long)(_value & 1); }
+
+  /**
+   * Makes sure there's room for the given number of bytes.
+   */
+  static void Reserve(ARRAY_REF(unsigned char, _bytes), int _size) {
+    if (ArraySize(_bytes) < _size) {
+      ArrayResize(_bytes, _size, _size);
+    }
+  }
+
+  /**
+   * Writes value as varint, 7 bits per byte, lowest bits first.
+   *
+   * @return
+   *   Returns position after the written value.
+   */
+  static int PutVarint(ARRAY_REF(unsigned char, _bytes), int _pos, unsigned long _value) {
+    Reserve(_bytes, _pos + 10);
+    while (_value >= 0x80) {
+      _bytes[_pos++] = (unsigned char)((_value & 0x7F) | 0x80);
+      _value >>= 7;
+    }
+    _bytes[_pos++] = (unsigned char)_value;
+    return _pos;
+  }
+
+  /**
+   * Reads varint.
+   *
+   * @param _pos
+   *   Position to read from, advanced past the value. Set past the end if value is truncated.
+   */
+  static unsigned long GetVarint(TICK_ARCHIVE_BYTES(_bytes), int &_pos, int _end) {
+    unsigned long _value = 0;
+    for (int _shift = 0; _pos < _end && _shift < 64; _shift += 7) {
+      unsigned char _byte = _bytes[_pos++];
+      _value |= (unsigned long)(_byte & 0x7F) << _shift;
+      if (_byte < 0x80) {
+        return _value;
+      }
+    }
+    _pos = _end + 1;
+    return 0;
+  }
+
+  /**
+   * Writes little-endian integer of the given number of bytes.
+   *
+   * @return
+   *   Returns position after the written value.
+   */
+  static int PutFixed(ARRAY_REF(unsigned char, _bytes), int _pos, long _value, int _size) {
+    Reserve(_bytes, _pos + _size);
+    for (int i = 0; i < _size; ++i) {
+      _bytes[_pos++] = (unsigned char)((_value >> (8 * i)) & 0xFF);
+    }
+    return _pos;
+  }
+
+  /**
+   * Reads little-endian integer of the given number of bytes.
+   */
+  static long GetFixed(TICK_ARCHIVE_BYTES(_bytes), int _pos, int _size) {
+    unsigned long _value = 0;
+    for (int i = 0; i < _size; ++i) {
+      _value |= (unsigned long)_bytes[_pos + i] << (8 * i);
+    }
+    return _size == 4 ? (long)(int)_value : (long)_value;
+  }
+
+  /**
+   * Writes entry of the index.
+   *
+   * @return
+   *   Returns position after the written entry.
+   */
+  static int PutChunk(ARRAY_REF(unsigned char, _bytes), int _pos, TickArchiveChunk &_chunk) {
+    _pos = PutFixed(_bytes, _pos, _chunk.offset, 8);
+    _pos = PutFixed(_bytes, _pos, _chunk.time_from, 8);
+    _pos = PutFixed(_bytes, _pos, _chunk.time_to, 8);
+    _pos = PutFixed(_bytes, _pos, _chunk.size, 4);
+    return PutFixed(_bytes, _pos, _chunk.count, 4);
+  }
+
+  /**
+   * Reads entry of the index.
+   */
+  static void GetChunk(TICK_ARCHIVE_BYTES(_bytes), int _pos, TickArchiveChunk &_chunk) {
+    _chunk.offset = GetFixed(_bytes, _pos, 8);
+    _chunk.time_from = GetFixed(_bytes, _pos + 8, 8);
+    _chunk.time_to = GetFixed(_bytes, _pos + 16, 8);
+    _chunk.size = (int)GetFixed(_bytes, _pos + 24, 4);
+    _chunk.count = (int)GetFixed(_bytes, _pos + 28, 4);
+  }
+
+  /**
+   * Encodes columns of the chunk.
+   *
+   * @return
+   *   Returns size of the encoded chunk.
+   */
+  static int EncodeChunk(ARRAY_REF(long, _times), ARRAY_REF(long, _bids), ARRAY_REF(long, _spreads),
+                         ARRAY_REF(long, _lasts), ARRAY_REF(long, _volumes), ARRAY_REF(long, _flags), int _count,
+                         ARRAY_REF(unsigned char, _bytes)) {
+    int _pos = 0;
+    // Time of the first tick is kept in the index, so the first delta is zero.
+    long _prev = _times[0];
+    for (int i = 0; i < _count; ++i) {
+      _pos = PutVarint(_bytes, _pos, ZigZag(_times[i] - _prev));
+      _prev = _times[i];
+    }
+    _prev = 0;
+    for (int i = 0; i < _count; ++i) {
+      _pos = PutVarint(_bytes, _pos, ZigZag(_bids[i] - _prev));
+      _prev = _bids[i];
+    }
+    _prev = 0;
+    for (int i = 0; i < _count; ++i) {
+      _pos = PutVarint(_bytes, _pos, ZigZag(_spreads[i] - _prev));
+      _prev = _spreads[i];
+    }
+    _prev = 0;
+    for (int i = 0; i < _count; ++i) {
+      _pos = PutVarint(_bytes, _pos, ZigZag(_lasts[i] - _prev));
+      _prev = _lasts[i];
+    }
+    for (int i = 0; i < _count; ++i) {
+      _pos = PutVarint(_bytes, _pos, (unsigned long)_volumes[i]);
+    }
+    for (int i = 0; i < _count; ++i) {
+      _pos = PutVarint(_bytes, _pos, (unsigned long)_flags[i]);
+    }
+    return _pos;
+  }
+
+  /**
+   * Decodes columns of the chunk.
+   *
+   * @return
+   *   Returns false if chunk is corrupted.
+   */
+  static bool DecodeChunk(TICK_ARCHIVE_BYTES(_bytes), TickArchiveChunk &_chunk, ARRAY_REF(long, _times),
+                          ARRAY_REF(long, _bids), ARRAY_REF(long, _spreads), ARRAY_REF(long, _lasts),
+                          ARRAY_REF(long, _volumes), ARRAY_REF(long, _flags)) {
+    int _count = _chunk.count, _end = _chunk.size, _pos = 0;
+    ArrayResize(_times, _count, TICK_ARCHIVE_CHUNK_SIZE);
+    ArrayResize(_bids, _count, TICK_ARCHIVE_CHUNK_SIZE);
+    ArrayResize(_spreads, _count, TICK_ARCHIVE_CHUNK_SIZE);
+    ArrayResize(_lasts, _count, TICK_ARCHIVE_CHUNK_SIZE);
+    ArrayResize(_volumes, _count, TICK_ARCHIVE_CHUNK_SIZE);
+    ArrayResize(_flags, _count, TICK_ARCHIVE_CHUNK_SIZE);
+    long _prev = _chunk.time_from;
+    for (int i = 0; i < _count; ++i) {
+      _prev += UnZigZag(GetVarint(_bytes, _pos, _end));
+      _times[i] = _prev;
+    }
+    _prev = 0;
+    for (int i = 0; i < _count; ++i) {
+      _prev += UnZigZag(GetVarint(_bytes, _pos, _end));
+      _bids[i] = _prev;
+    }
+    _prev = 0;
+    for (int i = 0; i < _count; ++i) {
+      _prev += UnZigZag(GetVarint(_bytes, _pos, _end));
+      _spreads[i] = _prev;
+    }
+    _prev = 0;
+    for (int i = 0; i < _count; ++i) {
+      _prev += UnZigZag(GetVarint(_bytes, _pos, _end));
+      _lasts[i] = _prev;
+    }
+    for (int i = 0; i < _count; ++i) {
+      _volumes[i] = (long)GetVarint(_bytes, _pos, _end);
+    }
+    for (int i = 0; i < _count; ++i) {
+      _flags[i] = (long)GetVarint(_bytes, _pos, _end);
+    }
+    return _pos == _end && (_count == 0 || _times[_count - 1] == _chunk.time_to);
+  }
+
+  /**
+   * Returns time of the tick in milliseconds.
+   */
+  static long GetTickTime(MqlTick &_tick) {
+#ifdef __MQL4__
+    // MQL4 ticks have no milliseconds.
+    return (long)_tick.time * 1000;
+#else
+    return _tick.time_msc != 0 ? _tick.time_msc : (long)_tick.time * 1000;
+#endif
+  }
+
+  /**
+   * Returns flags of the tick.
+   */
+  static long GetTickFlags(MqlTick &_tick) {
+#ifdef __MQL4__
+    // MQL4 ticks have no flags.
+    return 0;
+#else
+    return (long)_tick.flags;
+#endif
+  }
+
+  /**
+   * Converts price into integer points.
+   *
+   * @return
+   *   Returns false if price isn't rounded to the points, so it would be altered by storing it.
+   */
+  static bool ToPoints(double _price, long _scale, long &_points) {
+    _points = (long)MathRound(_price * _scale);
+    // Points are converted back the same way as the reader does, so only prices read back exactly are accepted.
+    return (double)_points / _scale == _price;
+  }
+
+  /**
+   * Returns multiplier converting prices into integer points.
+   */
+  static long GetScale(int _digits) {
+    long _scale = 1;
+    for (int i = 0; i < _digits; ++i) {
+      _scale *= 10;
+    }
+    return _scale;
+  }
+};
+
+/**
+ * Writes ticks into the compressed binary archive.
+ *
+ * Ticks are added in chronological order and written in chunks of fixed number of ticks (see TickArchiveCodec). The
+ * index of chunks by their time is written at the end of the file on Close(), so archive isn't readable until closed.
+ *
+ * File layout (little-endian):
+ * - header: magic, version, digits, chunk size, number of chunks (int each), reserved int, number of ticks, offset of
+ *   the index (long each), length of the symbol's name (int) and the name,
+ * - encoded chunks,
+ * - index: offset, first and last tick time (long each), size and number of ticks (int each) per chunk.
+ */
+class TickArchiveWriter {
+ protected:
+  // Symbol of the ticks and its digits.
+  string symbol;
+  int digits;
+  long scale;
+  // Maximum number of ticks per chunk.
+  int chunk_size;
+  // Columns of the pending chunk.
+  ARRAY(long, times);
+  ARRAY(long, bids);
+  ARRAY(long, spreads);
+  ARRAY(long, lasts);
+  ARRAY(long, volumes);
+  ARRAY(long, flags);
+  int count;
+  // Written chunks.
+  ARRAY(TickArchiveChunk, chunks);
+  long num_ticks;
+  // Offset of the next chunk.
+  long offset;
+  // Encoding buffer.
+  ARRAY(unsigned char, buffer);
+#ifdef __MQL__
+  int handle;
+#else
+  FILE *file;
+#endif
+
+  /* Protected methods */
+
+  /**
+   * Encodes header into the buffer.
+   *
+   * @return
+   *   Returns size of the header.
+   */
+  int PutHeader(long _index_offset) {
+    int _len = StringLen(symbol);
+    int _pos = TickArchiveCodec::PutFixed(buffer, 0, TICK_ARCHIVE_MAGIC, 4);
+    _pos = TickArchiveCodec::PutFixed(buffer, _pos, TICK_ARCHIVE_VERSION, 4);
+    _pos = TickArchiveCodec::PutFixed(buffer, _pos, digits, 4);
+    _pos = TickArchiveCodec::PutFixed(buffer, _pos, chunk_size, 4);
+    _pos = TickArchiveCodec::PutFixed(buffer, _pos, ArraySize(chunks), 4);
+    _pos = TickArchiveCodec::PutFixed(buffer, _pos, 0, 4);
+    _pos = TickArchiveCodec::PutFixed(buffer, _pos, num_ticks, 8);
+    _pos = TickArchiveCodec::PutFixed(buffer, _pos, _index_offset, 8);
+    _pos = TickArchiveCodec::PutFixed(buffer, _pos, _len, 4);
+    TickArchiveCodec::Reserve(buffer, _pos + _len);
+    for (int i = 0; i < _len; ++i) {
+#ifdef __MQL__
+      buffer[_pos++] = (unsigned char)StringGetCharacter(symbol, i);
+#else
+      buffer[_pos++] = (unsigned char)symbol[i];
+#endif
+    }
+    return _pos;
+  }
+
+  /**
+   * Writes bytes of the buffer at the current position.
+   */
+  bool Write(int _size) {
+#ifdef __MQL__
+    return FileWriteArray(handle, buffer, 0, _size) == (unsigned int)_size;
+#else
+    return fwrite(&buffer[0], 1, _size, file) == (size_t)_size;
+#endif
+  }
+
+ public:
+  /**
+   * Constructor.
+   *
+   * @param _digits
+   *   Digits of the prices. Symbol's digits are used when negative.
+   */
+  TickArchiveWriter(string _symbol = "", int _digits = -1, int _chunk_size = TICK_ARCHIVE_CHUNK_SIZE)
+      : symbol(StringLen(_symbol) > 0 ? _symbol : _Symbol),
+        chunk_size(_chunk_size > 0 ? _chunk_size : TICK_ARCHIVE_CHUNK_SIZE),
+        count(0),
+        num_ticks(0),
+        offset(0) {
+#ifdef __MQL__
+    handle = INVALID_HANDLE;
+#else
+    file = NULL;
+#endif
+    digits = _digits >= 0 ? _digits : (int)SymbolInfoInteger(symbol, SYMBOL_DIGITS);
+    scale = TickArchiveCodec::GetScale(digits);
+    ArrayResize(times, chunk_size);
+    ArrayResize(bids, chunk_size);
+    ArrayResize(spreads, chunk_size);
+    ArrayResize(lasts, chunk_size);
+    ArrayResize(volumes, chunk_size);
+    ArrayResize(flags, chunk_size);
+  }
+
+  /**
+   * Destructor.
+   */
+  ~TickArchiveWriter() { Close(); }
+
+  /* Getters */
+
+  /**
+   * Checks whether archive is open for writing.
+   */
+  bool IsOpen() {
+#ifdef __MQL__
+    return handle != INVALID_HANDLE;
+#else
+    return file != NULL;
+#endif
+  }
+
+  /**
+   * Returns number of added ticks.
+   */
+  long GetTicksCount() { return num_ticks + count; }
+
+  /**
+   * Returns number of written bytes.
+   */
+  long GetSize() { return offset; }
+
+  /* Modifiers */
+
+  /**
+   * Creates the archive, overwriting the existing file.
+   */
+  bool Open(string _path) {
+    Close();
+#ifdef __MQL__
+    handle = FileOpen(_path, FILE_WRITE | FILE_BIN);
+#else
+    file = fopen(_path.c_str(), "wb");
+#endif
+    if (!IsOpen()) {
+      return false;
+    }
+    ArrayResize(chunks, 0);
+    count = 0;
+    num_ticks = 0;
+    // Header is written again on Close(), when the index is known.
+    int _size = PutHeader(0);
+    offset = _size;
+    return Write(_size);
+  }
+
+  /**
+   * Adds tick. Ticks have to be added in chronological order.
+   *
+   * Prices are stored as integer points of the archive's digits, so ticks with prices not rounded to them (e.g., when
+   * archive has less digits than the symbol) are rejected rather than stored altered. Real volume isn't stored, it is
+   * read back as the volume.
+   *
+   * @return
+   *   Returns false if archive isn't open, tick is older than the last one, its prices aren't rounded to the digits
+   *   or chunk couldn't be written.
+   */
+  bool Add(MqlTick &_tick) {
+    long _time = TickArchiveCodec::GetTickTime(_tick);
+    long _bid, _ask, _last;
+    if (!IsOpen() || (count > 0 && _time < times[count - 1]) ||
+        (count == 0 && ArraySize(chunks) > 0 && _time < chunks[ArraySize(chunks) - 1].time_to) ||
+        !TickArchiveCodec::ToPoints(_tick.bid, scale, _bid) || !TickArchiveCodec::ToPoints(_tick.ask, scale, _ask) ||
+        !TickArchiveCodec::ToPoints(_tick.last, scale, _last)) {
+      return false;
+    }
+    times[count] = _time;
+    bids[count] = _bid;
+    spreads[count] = _ask - _bid;
+    lasts[count] = _last;
+    volumes[count] = (long)_tick.volume;
+    flags[count] = TickArchiveCodec::GetTickFlags(_tick);
+    return ++count < chunk_size || Flush();
+  }
+
+  /**
+   * Writes the pending chunk.
+   */
+  bool Flush() {
+    if (!IsOpen() || count == 0) {
+      return IsOpen();
+    }
+    TickArchiveChunk _chunk;
+    _chunk.offset = offset;
+    _chunk.time_from = times[0];
+    _chunk.time_to = times[count - 1];
+    _chunk.count = count;
+    _chunk.size = TickArchiveCodec::EncodeChunk(times, bids, spreads, lasts, volumes, flags, count, buffer);
+    if (!Write(_chunk.size)) {
+      return false;
+    }
+    int _index = ArraySize(chunks);
+    ArrayResize(chunks, _index + 1, 64);
+    chunks[_index] = _chunk;
+    offset += _chunk.size;
+    num_ticks += count;
+    count = 0;
+    return true;
+  }
+
+  /**
+   * Writes the pending chunk and the index, then closes the file.
+   */
+  bool Close() {
+    if (!IsOpen()) {
+      return false;
+    }
+    bool _result = Flush();
+    int _pos = 0;
+    for (int i = 0; i < ArraySize(chunks); ++i) {
+      _pos = TickArchiveCodec::PutChunk(buffer, _pos, chunks[i]);
+    }
+    _result &= Write(_pos);
+    long _index_offset = offset;
+    offset += _pos;
+    int _size = PutHeader(_index_offset);
+#ifdef __MQL__
+    _result &= FileSeek(handle, 0, SEEK_SET);
+    _result &= Write(_size);
+    FileClose(handle);
+    handle = INVALID_HANDLE;
+#else
+    _result &= fseek(file, 0, SEEK_SET) == 0;
+    _result &= Write(_size);
+    _result &= fclose(file) == 0;
+    file = NULL;
+#endif
+    return _result;
+  }
+};
+
+/**
+ * Reads ticks from the archive written by TickArchiveWriter.
+ *
+ * Chunks are located by their time in the index and decoded one at a time into integer columns. In C++ the file is
+ * memory-mapped, so chunks are decoded straight from the mapped pages without reading or copying the file. In MQL
+ * each decoded chunk is read into the buffer first.
+ */
+class TickArchiveReader {
+ protected:
+  // Symbol of the ticks and its digits.
+  string symbol;
+  int digits;
+  long scale;
+  int chunk_size;
+  long num_ticks;
+  // Index of the chunks.
+  ARRAY(TickArchiveChunk, chunks);
+  // Decoded chunk and its columns.
+  int chunk;
+  ARRAY(long, times);
+  ARRAY(long, bids);
+  ARRAY(long, spreads);
+  ARRAY(long, lasts);
+  ARRAY(long, volumes);
+  ARRAY(long, flags);
+#ifdef __MQL__
+  int handle;
+  // Bytes read from the file.
+  ARRAY(unsigned char, buffer);
+#else
+  int fd;
+  // Memory-mapped file.
+  unsigned char *data;
+  long data_size;
+#endif
+
+  /* Protected methods */
+
+  /**
+   * Makes the given range of the file available to decode (see TICK_ARCHIVE_SOURCE).
+   */
+  bool ReadBytes(long _offset, int _size) {
+    if (_offset < 0 || _size < 0) {
+      return false;
+    }
+#ifdef __MQL__
+    ArrayResize(buffer, _size, TICK_ARCHIVE_CHUNK_SIZE);
+    return _size == 0 ||
+           (FileSeek(handle, _offset, SEEK_SET) && FileReadArray(handle, buffer, 0, _size) == (unsigned int)_size);
+#else
+    return _offset + _size <= data_size;
+#endif
+  }
+
+ public:
+  /**
+   * Constructor.
+   */
+  TickArchiveReader() : digits(0), scale(1), chunk_size(0), num_ticks(0), chunk(-1) {
+#ifdef __MQL__
+    handle = INVALID_HANDLE;
+#else
+    fd = -1;
+    data = NULL;
+    data_size = 0;
+#endif
+  }
+
+  /**
+   * Destructor.
+   */
+  ~TickArchiveReader() { Close(); }
+
+  /* Getters */
+
+  /**
+   * Checks whether archive is open.
+   */
+  bool IsOpen() {
+#ifdef __MQL__
+    return handle != INVALID_HANDLE;
+#else
+    return data != NULL;
+#endif
+  }
+
+  /**
+   * Returns symbol of the ticks.
+   */
+  string GetSymbol() { return symbol; }
+
+  /**
+   * Returns digits of the prices.
+   */
+  int GetDigits() { return digits; }
+
+  /**
+   * Returns number of ticks in the archive.
+   */
+  long GetTicksCount() { return num_ticks; }
+
+  /**
+   * Returns number of chunks in the archive.
+   */
+  int GetChunksCount() { return ArraySize(chunks); }
+
+  /**
+   * Returns entry of the index.
+   */
+  TickArchiveChunk GetChunk(int _index) { return chunks[_index]; }
+
+  /**
+   * Returns index of the first chunk having ticks at or after the given time (in milliseconds).
+   *
+   * @return
+   *   Returns number of chunks if there are no such ticks.
+   */
+  int FindChunk(long _time_msc) {
+    int _lo = 0, _hi = ArraySize(chunks);
+    while (_lo < _hi) {
+      int _mid = (_lo + _hi) / 2;
+      if (chunks[_mid].time_to < _time_msc) {
+        _lo = _mid + 1;
+      } else {
+        _hi = _mid;
+      }
+    }
+    return _lo;
+  }
+
+  /**
+   * Returns number of ticks of the decoded chunk.
+   */
+  int Size() { return ArraySize(times); }
+
+  /**
+   * Returns time of the decoded tick in milliseconds.
+   */
+  long GetTime(int _index) { return times[_index]; }
+
+  /**
+   * Returns bid price of the decoded tick.
+   */
+  double GetBid(int _index) { return (double)bids[_index] / scale; }
+
+  /**
+   * Returns ask price of the decoded tick.
+   */
+  double GetAsk(int _index) { return (double)(bids[_index] + spreads[_index]) / scale; }
+
+  /**
+   * Returns last deal price of the decoded tick.
+   */
+  double GetLast(int _index) { return (double)lasts[_index] / scale; }
+
+  /**
+   * Returns volume of the decoded tick.
+   */
+  long GetVolume(int _index) { return volumes[_index]; }
+
+  /**
+   * Returns flags of the decoded tick.
+   */
+  long GetFlags(int _index) { return flags[_index]; }
+
+  /**
+   * Fills tick struct with the decoded tick.
+   */
+  void GetTick(int _index, MqlTick &_tick) {
+    _tick.time = (datetime)(times[_index] / 1000);
+    _tick.bid = GetBid(_index);
+    _tick.ask = GetAsk(_index);
+    _tick.last = GetLast(_index);
+    _tick.volume = (unsigned long)volumes[_index];
+#ifndef __MQL4__
+    _tick.time_msc = times[_index];
+    _tick.flags = (unsigned int)flags[_index];
+    _tick.volume_real = (double)volumes[_index];
+#endif
+  }
+
+  /* Modifiers */
+
+  /**
+   * Opens the archive and reads its index.
+   */
+  bool Open(string _path) {
+    Close();
+#ifdef __MQL__
+    handle = FileOpen(_path, FILE_READ | FILE_BIN);
+#else
+    fd = open(_path.c_str(), O_RDONLY);
+    struct stat _stat;
+    if (fd != -1 && fstat(fd, &_stat) == 0 && _stat.st_size > 0) {
+      void *_map = mmap(NULL, (size_t)_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (_map != MAP_FAILED) {
+        data = (unsigned char *)_map;
+        data_size = (long)_stat.st_size;
+      }
+    }
+#endif
+    if (!IsOpen() || !ReadBytes(0, TICK_ARCHIVE_HEADER_SIZE) ||
+        TickArchiveCodec::GetFixed(TICK_ARCHIVE_SOURCE(0), 0, 4) != TICK_ARCHIVE_MAGIC ||
+        TickArchiveCodec::GetFixed(TICK_ARCHIVE_SOURCE(0), 4, 4) != TICK_ARCHIVE_VERSION) {
+      Close();
+      return false;
+    }
+    digits = (int)TickArchiveCodec::GetFixed(TICK_ARCHIVE_SOURCE(0), 8, 4);
+    scale = TickArchiveCodec::GetScale(digits);
+    chunk_size = (int)TickArchiveCodec::GetFixed(TICK_ARCHIVE_SOURCE(0), 12, 4);
+    int _num_chunks = (int)TickArchiveCodec::GetFixed(TICK_ARCHIVE_SOURCE(0), 16, 4);
+    num_ticks = TickArchiveCodec::GetFixed(TICK_ARCHIVE_SOURCE(0), 24, 8);
+    long _index_offset = TickArchiveCodec::GetFixed(TICK_ARCHIVE_SOURCE(0), 32, 8);
+    int _len = (int)TickArchiveCodec::GetFixed(TICK_ARCHIVE_SOURCE(0), 40, 4);
+    if (_index_offset == 0 || _num_chunks < 0 || !ReadBytes(TICK_ARCHIVE_HEADER_SIZE, _len)) {
+      // Archive wasn't closed by the writer.
+      Close();
+      return false;
+    }
+#ifdef __MQL__
+    symbol = CharArrayToString(buffer, 0, _len);
+#else
+    symbol = string((const char *)data + TICK_ARCHIVE_HEADER_SIZE, _len);
+#endif
+
+    if (!ReadBytes(_index_offset, _num_chunks * TICK_ARCHIVE_INDEX_ENTRY_SIZE)) {
+      Close();
+      return false;
+    }
+    ArrayResize(chunks, _num_chunks);
+    for (int i = 0; i < _num_chunks; ++i) {
+      TickArchiveCodec::GetChunk(TICK_ARCHIVE_SOURCE(_index_offset), i * TICK_ARCHIVE_INDEX_ENTRY_SIZE, chunks[i]);
+    }
+    return true;
+  }
+
+  /**
+   * Closes the archive.
+   */
+  void Close() {
+#ifdef __MQL__
+    if (handle != INVALID_HANDLE) {
+      FileClose(handle);
+      handle = INVALID_HANDLE;
+    }
+#else
+    if (data != NULL) {
+      munmap(data, (size_t)data_size);
+      data = NULL;
+      data_size = 0;
+    }
+    if (fd != -1) {
+      ::close(fd);
+      fd = -1;
+    }
+#endif
+    ArrayResize(chunks, 0);
+    ArrayResize(times, 0);
+    chunk = -1;
+  }
+
+  /**
+   * Decodes the given chunk, unless it is already decoded.
+   *
+   * @return
+   *   Returns false if chunk doesn't exist or is corrupted.
+   */
+  bool ReadChunk(int _index) {
+    if (_index == chunk) {
+      return true;
+    }
+    chunk = -1;
+    ArrayResize(times, 0);
+    if (_index < 0 || _index >= ArraySize(chunks) || !ReadBytes(chunks[_index].offset, chunks[_index].size) ||
+        !TickArchiveCodec::DecodeChunk(TICK_ARCHIVE_SOURCE(chunks[_index].offset), chunks[_index], times, bids,
+                                       spreads, lasts, volumes, flags)) {
+      ArrayResize(times, 0);
+      return false;
+    }
+    chunk = _index;
+    return true;
+  }
+
+  /**
+   * Loads ticks of the given time range into the buffer, keyed by their time in milliseconds.
+   *
+   * Ticks of each chunk within the range are converted at once and handed over to BufferSeries::AddRange(), so they are
+   * appended to the buffer in bulk.
+   *
+   * @param _to_msc
+   *   Time of the last tick to load, inclusive. Zero for all the ticks since the given time.
+   *
+   * @return
+   *   Returns number of loaded ticks or -1 on corrupted chunk.
+   */
+  template <typename TV>
+  int Load(BufferTick<TV> &_buffer, long _from_msc = 0, long _to_msc = 0) {
+    int _result = 0;
+    ARRAY(TickAB<TV>, _ticks);
+    ARRAY(long, _keys);
+    for (int c = FindChunk(_from_msc); c < ArraySize(chunks); ++c) {
+      if (_to_msc > 0 && chunks[c].time_from > _to_msc) {
+        break;
+      }
+      if (!ReadChunk(c)) {
+        return -1;
+      }
+      // Ticks are in chronological order, so the range is a continuous span of the chunk.
+      int _begin = 0, _end = ArraySize(times);
+      while (_begin < _end && times[_begin] < _from_msc) {
+        ++_begin;
+      }
+      while (_end > _begin && _to_msc > 0 && times[_end - 1] > _to_msc) {
+        --_end;
+      }
+      int _count = _end - _begin;
+      ArrayResize(_ticks, _count, TICK_ARCHIVE_CHUNK_SIZE);
+      ArrayResize(_keys, _count, TICK_ARCHIVE_CHUNK_SIZE);
+      for (int i = 0; i < _count; ++i) {
+        _ticks[i].ask = (TV)GetAsk(_begin + i);
+        _ticks[i].bid = (TV)GetBid(_begin + i);
+        _keys[i] = times[_begin + i];
+      }
+      _result += _buffer.AddRange(_ticks, _keys, _count);
+    }
+    return _result;
+  }
+
+  /**
+   * Feeds ticks of the given time range to the tick indicator (see IndicatorTick::SetTick()).
+   *
+   * Ticks are keyed by their time in seconds, as ticks of IndicatorTickReal are, so the last tick of each second is
+   * kept.
+   *
+   * @return
+   *   Returns number of fed ticks or -1 on corrupted chunk.
+   */
+  template <typename T>
+  int Feed(T *_indi, long _from_msc = 0, long _to_msc = 0) {
+    int _result = 0;
+    MqlTick _tick;
+    for (int c = FindChunk(_from_msc); c < ArraySize(chunks); ++c) {
+      if (_to_msc > 0 && chunks[c].time_from > _to_msc) {
+        break;
+      }
+      if (!ReadChunk(c)) {
+        return -1;
+      }
+      for (int i = 0; i < ArraySize(times); ++i) {
+        if (times[i] >= _from_msc && (_to_msc <= 0 || times[i] <= _to_msc)) {
+          GetTick(i, _tick);
+          _indi PTR_DEREF SetTick(_tick, times[i] / 1000);
+          ++_result;
+        }
+      }
+    }
+    return _result;
+  }
+};
+
+#endif  // TICK_ARCHIVE_H
@@ -0,0 +1,106 @@
+//+------------------------------------------------------------------+
+//|                                                EA31337 framework |
+//|                                 Copyright 2016-2023, EA31337 Ltd |
+//|                                       https://github.com/EA31337 |
+//+------------------------------------------------------------------+
+
+/*
+ * This file is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file
+ * Test functionality of TickArchive classes in C++, where archive is read through mmap().
+ */
+
+// Includes standard libraries.
+#include <cstdlib>
+
+// Includes.
+#include "../../Native/Native.h"
+#include "../TickArchive.h"
+
+#define TICK_ARCHIVE_TEST_CHECK(cond, msg)       \
+  if (!(cond)) {                                 \
+    fprintf(stderr, "Test failed: %s\n", (msg)); \
+    return 1;                                    \
+  }
+
+int main(int argc, char **argv) {
+  // Generates random ticks, prices are kept in integer points to be exact.
+  int _num_ticks = 10000;
+  ARRAY(MqlTick, _ticks);
+  ArrayResize(_ticks, _num_ticks);
+  long _time = 1577836800000;  // 2020.01.01 00:00.
+  long _bid = 110000;
+  for (int i = 0; i < _num_ticks; ++i) {
+    _time += rand() % 3000;
+    _bid += rand() % 11 - 5;
+    _ticks[i].time = (datetime)(_time / 1000);
+    _ticks[i].time_msc = _time;
+    _ticks[i].bid = _bid / 100000.0;
+    _ticks[i].ask = (_bid + 8 + rand() % 3) / 100000.0;
+    _ticks[i].last = rand() % 4 == 0 ? _ticks[i].bid : 0;
+    _ticks[i].volume = rand() % 3;
+    _ticks[i].volume_real = (double)_ticks[i].volume;
+    _ticks[i].flags = TICK_FLAG_BID | (_ticks[i].last > 0 ? TICK_FLAG_LAST : 0);
+  }
+
+  // Writes ticks in chunks of 1000 ticks.
+  string _path = "TickArchiveTest.bin";
+  TickArchiveWriter _writer("EURUSD", 5, 1000);
+  TICK_ARCHIVE_TEST_CHECK(_writer.Open(_path), "Cannot create the archive!");
+  for (int i = 0; i < _num_ticks; ++i) {
+    TICK_ARCHIVE_TEST_CHECK(_writer.Add(_ticks[i]), "Cannot add tick!");
+  }
+  TICK_ARCHIVE_TEST_CHECK(!_writer.Add(_ticks[0]), "Older tick shouldn't be added!");
+  TICK_ARCHIVE_TEST_CHECK(_writer.Close(), "Cannot close the archive!");
+
+  // Maps the archive back and reads all the ticks.
+  TickArchiveReader _reader;
+  TICK_ARCHIVE_TEST_CHECK(_reader.Open(_path), "Cannot open the archive!");
+  TICK_ARCHIVE_TEST_CHECK(_reader.GetSymbol() == "EURUSD" && _reader.GetDigits() == 5, "Wrong symbol of the archive!");
+  TICK_ARCHIVE_TEST_CHECK(_reader.GetTicksCount() == _num_ticks && _reader.GetChunksCount() == 10,
+                          "Wrong number of ticks!");
+  int _index = 0;
+  for (int c = 0; c < _reader.GetChunksCount(); ++c) {
+    TICK_ARCHIVE_TEST_CHECK(_reader.ReadChunk(c), "Cannot decode chunk!");
+    for (int i = 0; i < _reader.Size(); ++i, ++_index) {
+      MqlTick _tick;
+      _reader.GetTick(i, _tick);
+      TICK_ARCHIVE_TEST_CHECK(_tick.time_msc == _ticks[_index].time_msc && _tick.bid == _ticks[_index].bid &&
+                                  _tick.ask == _ticks[_index].ask && _tick.last == _ticks[_index].last &&
+                                  _tick.volume == _ticks[_index].volume && _tick.flags == _ticks[_index].flags,
+                              "Wrong tick!");
+    }
+  }
+  TICK_ARCHIVE_TEST_CHECK(_index == _num_ticks, "Not all ticks were read!");
+
+  // Chunks are found by time.
+  long _from = _ticks[2500].time_msc, _to = _ticks[5500].time_msc;
+  TICK_ARCHIVE_TEST_CHECK(_reader.FindChunk(_from) == 2 && _reader.FindChunk(_to) == 5, "Wrong chunk found!");
+  TICK_ARCHIVE_TEST_CHECK(_reader.FindChunk(_time + 1) == _reader.GetChunksCount(), "No chunk should be found!");
+
+  // Truncated archive isn't opened.
+  _reader.Close();
+  FILE *_file = fopen(_path.c_str(), "r+b");
+  TICK_ARCHIVE_TEST_CHECK(_file != NULL && ftruncate(fileno(_file), TICK_ARCHIVE_HEADER_SIZE) == 0,
+                          "Cannot truncate the archive!");
+  fclose(_file);
+  TICK_ARCHIVE_TEST_CHECK(!_reader.Open(_path), "Truncated archive shouldn't be opened!");
+  remove(_path.c_str());
+  printf("Read back %d ticks.\n", _index);
+  return 0;
+}